@@ -0,0 +1,68 @@
+#pragma once
+#include "AssetManager.hpp"
+#include "MainThreadDispatcher.hpp"
+#include <coroutine>
+#include <string>
+
+using namespace std;
+
+
+/**
+ * Awaitables for Task<> coroutines that wait on AssetManager
+ *
+ * Each one checks once per frame on the main thread (through MainThreadDispatcher), so the
+ * coroutine always resumes on the main thread and the checks never block a frame.
+ *
+ * Usage:
+ *   if (co_await textureLoaded("tile000.png")) { ... }     // false if the load failed or was cancelled
+ *   co_await texturesLoaded();                             // every requested texture is in
+ */
+namespace asset_awaitables_detail {
+    // Re-post the check each frame until done() holds, then resume on the main thread
+    template<typename Done>
+    void resumeWhen(coroutine_handle<> handle, Done done) {
+        MainThreadDispatcher::getInstance().post([handle, done]() mutable {
+            if (done())
+                handle.resume();
+            else
+                resumeWhen(handle, move(done));
+        });
+    }
+}
+
+/** co_await textureLoaded(name) -> bool: true once uploaded, false if it is not (or no longer) requested */
+inline auto textureLoaded(string name) {
+    struct Awaiter {
+        string name;
+        bool loaded;
+
+        auto await_ready() const noexcept -> bool { return false; }
+
+        void await_suspend(coroutine_handle<> handle) {
+            asset_awaitables_detail::resumeWhen(handle, [this]() {
+                auto& assetManager = AssetManager::getInstance();
+                this->loaded = assetManager.isTextureLoaded(this->name);
+                return this->loaded || !assetManager.isTextureRequested(this->name);
+            });
+        }
+
+        auto await_resume() const noexcept -> bool { return this->loaded; }
+    };
+    return Awaiter{move(name), false};
+}
+
+/** co_await texturesLoaded(): every texture requested so far is uploaded (or has failed) */
+inline auto texturesLoaded() {
+    struct Awaiter {
+        auto await_ready() const noexcept -> bool { return false; }
+
+        void await_suspend(coroutine_handle<> handle) {
+            asset_awaitables_detail::resumeWhen(handle, []() {
+                return AssetManager::getInstance().isLoadingComplete();
+            });
+        }
+
+        void await_resume() const noexcept {}
+    };
+    return Awaiter{};
+}
@@ -4,68 +4,223 @@
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include <array>
 #include <memory>
 #include <queue>
 #include <mutex>
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <filesystem>
 #include <algorithm>
+#include <chrono>
+#include <semaphore>
+#include <cstdint>
+#include "TextureAtlas.hpp"
+#include "MainThreadDispatcher.hpp"
 #include "../utils/ThreadPool.hpp"
+#include "../utils/AssetArchive.hpp"
+#include "../utils/AssetManifest.hpp"
+#include "../utils/BufferPool.hpp"
+#include "../utils/TaskQueue.hpp"
+#include "../utils/CancellationToken.hpp"
+#include "../utils/MpscChannel.hpp"
 
 using namespace std;
 using namespace sf;
 
 
+// Shared, read-only handle to a cached font (nullptr if the font failed to load)
+using FontHandle = shared_ptr<const Font>;
+
+// Dense integer handle for a loaded texture (index in finalize order)
+using TextureId = int32_t;
+constexpr TextureId INVALID_TEXTURE_ID = -1;
+
+// Texture ordinal (see resolveTextureId) meaning "no texture"
+constexpr size_t NO_TEXTURE_ORDINAL = SIZE_MAX;
+
+
 /**
- * AssetManager - Singleton texture/icon loading and caching system (header-only)
+ * AssetManager - Singleton texture/icon/font loading and caching system (header-only)
  *
  * Features:
  * - On-demand background texture loading using ThreadPool (doesn't block main game loop)
+ * - Pipelined stages: I/O pool -> bounded -> decode pool -> bounded -> main-thread upload,
+ *   each with its own concurrency, so the disk and all cores stay busy at the same time
+ * - Loose-file reads borrow size-classed buffers from a capped BufferPool (no per-asset
+ *   allocation once warmed up, bounded peak staging memory)
  * - O(1) lookup performance with insertion order preservation
- * - Thread-safe two-phase loading (file I/O in background, SFML creation on main thread)
+ * - Dense TextureId handles for hot paths (array index, no string hashing or refcounting)
+ * - Thread-safe two-phase loading (file I/O + PNG decode in background, GPU upload on main thread)
+ *   with a lock-free handoff: workers never contend with each other or the main thread
  * - Automatic resource caching and sharing to prevent duplicate loads
+ *   (in-flight requests are tracked too, so each file is read and decoded exactly once)
+ * - Icons packed into shared atlas pages so renderers can batch by page
+ * - Fonts loaded once in background and shared by every entity (one glyph cache per font)
+ * - Packed icon archive (assets/images/icons.pak) is memory-mapped when present,
+ *   falling back to loose files in assets/images/icons for development
+ * - Build-time manifest (assets/images/icons.manifest) lists every icon with its size,
+ *   so enumeration skips the directory scan and progress is byte-accurate
+ * - Per-frame finalize budget (time and/or bytes) so upload bursts don't stall a frame;
+ *   uploads also stop once the MainThreadDispatcher's shared frame slice is spent
+ * - Prioritized requests (on-screen textures ahead of the bulk fill) that can be
+ *   withdrawn before they start, e.g. on scene change
  *
  * Usage:
  *   // Request texture to load in background
  *   AssetManager::getInstance().loadTexture("tile000.png");
  *
- *   // In game loop - process loaded textures (call each frame)
- *   AssetManager::getInstance().update();
+ *   // Once at startup - process loaded textures every frame as a main-thread job
+ *   AssetManager::getInstance().scheduleFrameUpdates();
+ *
+ *   // Retrieve loaded texture region (empty if not ready yet)
+ *   auto region = AssetManager::getInstance().getTexture("tile000.png");
+ *   if (region) {
+ *       sprite.setTexture(*region.page);
+ *       sprite.setTextureRect(region.rect);
+ *   }
+ *
+ *   // Hot paths: resolve a TextureId once, then index by it every frame
+ *   auto id = AssetManager::getInstance().getTextureId("tile000.png");
+ *   auto region = AssetManager::getInstance().getTexture(id);
  *
- *   // Retrieve loaded texture (returns nullptr if not ready yet)
- *   auto texture = AssetManager::getInstance().getTexture("tile000.png");
- *   if (texture) {
- *       sprite.setTexture(*texture);
+ *   // Fonts: queue early, then share one handle between entities
+ *   AssetManager::getInstance().loadFont(AssetManager::UI_FONT);
+ *   auto font = AssetManager::getInstance().tryGetFont(AssetManager::UI_FONT);  // Each frame until set
+ *   if (font) {
+ *       text.setFont(*font);
  *   }
+ *   // (entities use a FontBinding, which does this polling for them)
  */
 class AssetManager {
-    ThreadPool loadingPool;
-    unordered_map<string, shared_ptr<Texture>> textureCache;
-    vector<string> textureOrder;
-    size_t totalTextureCount;
+    static constexpr auto ICONS_DIR = "assets/images/icons";
+    static constexpr auto ICONS_ARCHIVE = "assets/images/icons.pak";
+    static constexpr auto ICONS_MANIFEST = "assets/images/icons.manifest";
+
+    // Pipeline sizing: a small I/O stage next to a decode stage sized to the cores.
+    // Files in flight are bounded by decodeSlots and the staging cap, not by I/O threads.
+    static constexpr size_t MAPPED_IO_THREADS = 2;  // Archive lookups only hand out mmap spans
+    static constexpr ptrdiff_t DECODE_QUEUE_CAPACITY = 32;  // Files read but not yet decoded
+    static constexpr ptrdiff_t UPLOAD_QUEUE_CAPACITY = 64;  // Images decoded but not yet uploaded
+    static constexpr size_t DEFAULT_STAGING_CAP = 64 * 1024 * 1024;  // Pooled file buffers
+    static constexpr size_t ONSCREEN_TEXTURE_COUNT = 10;    // Loaded first by loadAllTextures()
+
+    AssetArchive iconArchive;   // Mapped once in the constructor, then read-only
+    AssetManifest iconManifest; // Loaded once in the constructor, then read-only
+    TextureAtlas iconAtlas;
+    unordered_map<string, TextureId> textureCache;
+    vector<string> textureOrder;            // Indexed by TextureId
+    vector<TextureRegion> textureRegions;   // Indexed by TextureId
+    struct LoadRequest {
+        TaskPriority priority;  // Best lane it has been queued in
+        bool started;           // Claimed by the I/O stage (later duplicates bail)
+        bool listed;            // In the manifest when requested (counted in bytes, not unlisted)
+        uint64_t listedSize;    // Manifest file size when requested, 0 if unlisted
+    };
+    unordered_map<string, LoadRequest> requestedTextures;  // Queued, in flight or loaded
+    mutable mutex requestedMutex;             // Protects requestedTextures and loadToken
+    CancellationToken loadToken;              // Cancelled (and replaced) by cancelPendingLoads()
+    atomic<size_t> totalTextureCount;         // Unique requests not known to have failed
+    atomic<uint64_t> totalTextureBytes;       // File bytes of requests listed in the manifest
+    atomic<size_t> unlistedTextureCount;      // Requests missing from the manifest (no byte size)
+    uint64_t loadedTextureBytes;              // Main thread only
+    struct FontEntry {
+        once_flag loadOnce;         // Whoever gets here first (worker or main thread) loads
+        vector<char> fileData;      // sf::Font reads from this lazily - must outlive font
+        shared_ptr<Font> font;      // nullptr until loaded, stays nullptr on failure
+        atomic<bool> ready{false};  // Load finished (font set or failed); never blocks to check
+    };
+    unordered_map<string, shared_ptr<FontEntry>> fontCache;
+    mutable mutex fontMutex;        // Protects fontCache map (entries load via loadOnce)
+    struct FetchJob {
+        string key;             // Asset identifier (filename)
+        uint64_t expectedSize;  // LoadRequest::listedSize
+    };
+    struct DecodeJob {
+        string key;             // Asset identifier (filename)
+        uint64_t listedSize;    // LoadRequest::listedSize, added to loaded bytes once finalized
+        span<const char> mapped;  // Zero-copy bytes from the archive, or empty
+        PooledBuffer fileData;    // Borrowed bytes from a loose file, or empty
+    };
     struct PendingAsset {
         string key;             // Asset identifier (filename)
-        vector<char> fileData;  // Raw file bytes loaded in background
+        uint64_t listedSize;    // LoadRequest::listedSize
+        Image image;            // Decoded RGBA pixels (decoded in background)
     };
-    queue<PendingAsset> pendingAssets;
-    mutable mutex pendingMutex;  // Protects pendingAssets queue
+    MpscChannel<PendingAsset> pendingAssets;  // Workers push (lock-free), main thread drains
+    queue<PendingAsset> finalizeBacklog;  // Main thread only: decoded but not yet uploaded
+
+    // Per-frame finalize budget (0 = unlimited)
+    chrono::microseconds finalizeTimeBudget;
+    size_t finalizeByteBudget;
+
+    TaskQueue<FetchJob> fetchQueue;  // Stage 1 input, by priority; each I/O task pops one
+    BufferPool stagingBuffers;  // Loose-file read buffers, returned once decoded
+
+    // Stage backpressure: a stage blocks on a slot before handing work to the next one
+    counting_semaphore<> decodeSlots;
+    counting_semaphore<> uploadSlots;
+
+    // I/O -> decode hand-offs live here, one per decodeSlots permit, so the decode task
+    // captures only an index and fits UniqueTask's inline storage (no allocation per asset)
+    array<DecodeJob, DECODE_QUEUE_CAPACITY> decodeJobs;
+    vector<size_t> freeDecodeJobs;  // Indices into decodeJobs not in use
+    mutex decodeJobsMutex;          // Protects freeDecodeJobs
+    atomic<bool> stopping;      // Set on destruction so queued/blocked stage work bails out
+
+    // Declared last so they are destroyed (joined) first, while everything above is alive.
+    // ioPool is joined before decodePool because I/O tasks enqueue into the decode pool.
+    ThreadPool decodePool;      // Stage 2: PNG decode into sf::Image
+    ThreadPool ioPool;          // Stage 1: read file bytes / look up archive spans
 
     AssetManager()
-        : loadingPool(thread::hardware_concurrency()),
+        : iconArchive(),
+          iconManifest(),
+          iconAtlas(),
           textureCache(),
           textureOrder(),
+          textureRegions(),
+          requestedTextures(),
+          requestedMutex(),
+          loadToken(CancellationToken::create()),
           totalTextureCount(0),
-          pendingAssets(),
-          pendingMutex() {
+          totalTextureBytes(0),
+          unlistedTextureCount(0),
+          loadedTextureBytes(0),
+          fontCache(),
+          fontMutex(),
+          pendingAssets(UPLOAD_QUEUE_CAPACITY),     // Never full: pushes hold an upload slot
+          finalizeBacklog(),
+          finalizeTimeBudget(2000),
+          finalizeByteBudget(0),
+          fetchQueue(),
+          stagingBuffers(DEFAULT_STAGING_CAP),
+          decodeSlots(DECODE_QUEUE_CAPACITY),
+          uploadSlots(UPLOAD_QUEUE_CAPACITY),
+          decodeJobs(),
+          freeDecodeJobs(),
+          decodeJobsMutex(),
+          stopping(false),
+          decodePool(max(1u, thread::hardware_concurrency())),
+          ioPool(this->openIconSources()) {
+        for (auto i = size_t(0); i < this->decodeJobs.size(); i++)
+            this->freeDecodeJobs.push_back(i);
     }
 
 public:
+    static constexpr auto UI_FONT = "sansation.ttf";   // Shared by every text entity
+
     static auto getInstance() -> AssetManager& {
         static auto instance = AssetManager();
         return instance;
     }
 
+    ~AssetManager() {
+        this->stopping = true;  // Pools join next (declared last); stage tasks see this and bail
+        this->stagingBuffers.shutdown();    // Wake I/O workers blocked on the staging cap
+    }
+
     AssetManager(const AssetManager&) = delete;
     auto operator=(const AssetManager&) -> AssetManager& = delete;
     AssetManager(AssetManager&&) = delete;
@@ -73,82 +228,218 @@ public:
 
     /**
      * Request a texture to be loaded asynchronously in background
-     * Safe to call multiple times with same filename (will only load once)
+     * Safe to call multiple times with same filename, from any thread (will only load once)
+     * Requesting a still-queued texture again at a higher priority moves it up.
+     * @return true if this call queued a new load, false if already loaded, queued or in flight
      */
-    void loadTexture(const string& filename) {
-        // Skip if already loaded or pending
-        if (this->isTextureLoaded(filename))
-            return;
+    auto loadTexture(const string& filename, TaskPriority priority = TaskPriority::Normal) -> bool {
+        return this->loadTextures(span<const string>(&filename, 1), priority) > 0;
+    }
 
-        this->totalTextureCount++;
+    /**
+     * Batched loadTexture(): one lock round-trip per queue for the whole batch
+     * @return Number of textures newly queued
+     */
+    auto loadTextures(span<const string> filenames, TaskPriority priority = TaskPriority::Normal) -> size_t {
+        auto fetches = vector<FetchJob>();
+        auto token = CancellationToken();
+        auto added = size_t(0);
+        {
+            auto lock = lock_guard<mutex>(this->requestedMutex);
+            for (const auto& filename : filenames) {
+                // One entry per asset, however many callers
+                auto [it, inserted] = this->requestedTextures.try_emplace(filename, LoadRequest{priority, false, false, 0});
+                auto& request = it->second;
+                if (inserted) {
+                    // Known size lets the loader allocate once and count progress in bytes;
+                    // recorded now so every later count uses the same answer
+                    const auto* listed = this->iconManifest.find(filename);
+                    request.listed = listed != nullptr;
+                    request.listedSize = listed ? listed->size : uint64_t(0);
+                    this->countRequest(request);
+                    added++;
+                } else {
+                    // Loaded/in flight, or already queued at least this high
+                    if (request.started || priority >= request.priority)
+                        continue;
+                    request.priority = priority;    // Promote: queue a copy in the higher lane
+                }
+                fetches.push_back({filename, request.listedSize});
+            }
+            this->totalTextureCount += added;
+            token = this->loadToken;
+        }
 
-        // Enqueue background task to load texture file data
-        this->loadingPool.enqueue([this, filename]() {
-            auto fullPath = "assets/images/icons/" + filename;
+        if (fetches.empty())
+            return 0;
 
-            // Read file into memory
-            auto buffer = readFileIntoMemory(fullPath);
-            if (buffer.empty())
-                return;
+        // One I/O task per fetch; each takes the most urgent queued fetch, not necessarily its own
+        auto tasks = vector<UniqueTask>();
+        tasks.reserve(fetches.size());
+        for (auto i = size_t(0); i < fetches.size(); i++) {
+            tasks.emplace_back([this]() {
+                if (auto job = this->fetchQueue.tryPop())
+                    this->fetchAndForward(*job);
+            });
+        }
 
-            // Add to pending queue (will be processed on main thread)
-            {
-                auto lock = lock_guard<mutex>(this->pendingMutex);
-                this->pendingAssets.push({filename, move(buffer)});
-            }
-            cout << "[AssetManager] Loaded texture data: " 
-                 << filename << " (" << buffer.size() << " bytes)" << endl;
-        });
+        this->fetchQueue.pushBulk(move(fetches), priority, token);
+        this->ioPool.enqueueBulk(move(tasks));
+        return added;
     }
 
     /**
-     * Scan assets directory and queue all PNG textures for loading
-     * @return Number of textures queued for loading
+     * Withdraw every texture load that hasn't started yet (e.g. on scene change)
+     * Loads already reading or decoding finish normally. Withdrawn textures stop counting
+     * toward progress and may be requested again later.
+     * @return Number of loads withdrawn
      */
-    auto loadAllTextures() -> size_t {
-        auto iconsPath = filesystem::path("assets/images/icons");
-
-        if (!filesystem::exists(iconsPath) || !filesystem::is_directory(iconsPath)) {
-            cerr << "[AssetManager] Warning: assets/images/icons directory not found" << endl;
-            return 0;
+    auto cancelPendingLoads() -> size_t {
+        auto withdrawn = size_t(0);
+        {
+            auto lock = lock_guard<mutex>(this->requestedMutex);
+            this->loadToken.cancel();
+            this->loadToken = CancellationToken::create();
+
+            for (auto it = this->requestedTextures.begin(); it != this->requestedTextures.end();) {
+                if (it->second.started) {
+                    ++it;
+                    continue;
+                }
+                this->uncountRequest(it->second);
+                it = this->requestedTextures.erase(it);
+                withdrawn++;
+            }
         }
 
-        // Collect all PNG files
-        auto pngFiles = vector<string>();
-        for (const auto& entry : filesystem::directory_iterator(iconsPath))
-            if (entry.is_regular_file() && entry.path().extension() == ".png")
-                pngFiles.push_back(entry.path().filename().string());
+        // Free the queued jobs now; their I/O tasks find nothing and return
+        this->fetchQueue.dropCancelled();
+        if (withdrawn > 0)
+            cout << "[AssetManager] Cancelled " << withdrawn << " pending texture loads" << endl;
+        return withdrawn;
+    }
 
-        // Sort files to ensure consistent loading order
-        sort(pngFiles.begin(), pngFiles.end());
+    /**
+     * Request a font to be loaded asynchronously in background
+     * Safe to call multiple times with same filename (will only load once)
+     */
+    void loadFont(const string& filename) {
+        auto [entry, created] = this->findOrCreateFontEntry(filename);
+        if (created)
+            this->queueFontLoad(entry, filename);
+    }
+
+    /**
+     * Get a shared font handle, loading it now if the background load hasn't started yet
+     * If a worker is mid-load, waits only for that single file (never for queued textures)
+     */
+    auto getFont(const string& filename) -> FontHandle {
+        auto [entry, created] = this->findOrCreateFontEntry(filename);
+        this->ensureFontLoaded(*entry, filename);
+        if (!entry->font)
+            return nullptr;
+
+        // Aliasing handle keeps the whole entry (including fileData) alive with the font
+        return FontHandle(entry, entry->font.get());
+    }
 
-        // Queue all found textures for loading
-        for (const auto& filename : pngFiles)
-            this->loadTexture(filename);
+    /**
+     * Get a shared font handle without waiting: nullptr until the background load finishes
+     * (queues the load if nobody has yet). Use from draw code instead of getFont()
+     */
+    auto tryGetFont(const string& filename) -> FontHandle {
+        auto [entry, created] = this->findOrCreateFontEntry(filename);
+        if (created)
+            this->queueFontLoad(entry, filename);
+        if (!entry->ready.load(memory_order_acquire) || !entry->font)
+            return nullptr;
+
+        return FontHandle(entry, entry->font.get());
+    }
 
-        cout << "[AssetManager] Queued " << pngFiles.size() << " textures for loading" << endl;
-        return pngFiles.size();
+    /**
+     * Queue all PNG textures for loading
+     * Enumerates from the packed archive or the manifest when available (both sorted),
+     * otherwise scans the directory
+     * @return Number of textures newly queued (already loaded/in-flight ones are not counted)
+     */
+    auto loadAllTextures() -> size_t {
+        auto pngFiles = this->iconArchive.isOpen() ? this->listArchivedIcons()
+                      : this->iconManifest.isLoaded() ? this->listManifestIcons()
+                      : this->listLooseIcons();
+
+        // Queue all found textures for loading (already loaded/in-flight ones are skipped).
+        // The first screenful goes ahead of the bulk fill so pieces get textures soonest.
+        auto files = span<const string>(pngFiles);
+        auto onscreen = min(files.size(), ONSCREEN_TEXTURE_COUNT);
+        auto queued = this->loadTextures(files.first(onscreen), TaskPriority::High)
+                    + this->loadTextures(files.subspan(onscreen), TaskPriority::Background);
+
+        cout << "[AssetManager] Queued " << queued << " of " << pngFiles.size() << " textures for loading" << endl;
+        return queued;
     }
 
     /**
      * Process pending assets loaded in background threads
      * MUST be called each frame from main thread to finalize SFML resources
+     * (scheduleFrameUpdates() does this through the MainThreadDispatcher)
      */
     void update() {
         this->processPendingAssets();
     }
 
-    auto getTexture(const string& name) -> shared_ptr<Texture> {
+    /** Run update() every frame as a High-priority MainThreadDispatcher job (shares its budget) */
+    void scheduleFrameUpdates() {
+        MainThreadDispatcher::getInstance().post([this]() {
+            this->update();
+            this->scheduleFrameUpdates();   // Re-posted jobs run next frame
+        }, TaskPriority::High);
+    }
+
+    auto getTexture(const string& name) const -> TextureRegion {
+        return this->getTexture(this->getTextureId(name));
+    }
+
+    /** O(1) array lookup; returns an empty region for unloaded/invalid ids */
+    auto getTexture(TextureId id) const -> TextureRegion {
+        return this->isValidTextureId(id)
+            ? this->textureRegions[static_cast<size_t>(id)]
+            : TextureRegion();
+    }
+
+    auto getTextureId(const string& name) const -> TextureId {
         auto it = this->textureCache.find(name);
         return it != this->textureCache.end()
             ? it->second
-            : nullptr;
+            : INVALID_TEXTURE_ID;
+    }
+
+    /**
+     * Map an arbitrary ordinal (e.g. a per-piece counter) onto a loaded texture
+     * The result changes as more textures load, so keep the ordinal and resolve it when drawing.
+     * @return ordinal wrapped by the loaded texture count, or INVALID_TEXTURE_ID if none
+     *         loaded (or ordinal is NO_TEXTURE_ORDINAL)
+     */
+    auto resolveTextureId(size_t ordinal) const -> TextureId {
+        return ordinal != NO_TEXTURE_ORDINAL && !this->textureRegions.empty()
+            ? static_cast<TextureId>(ordinal % this->textureRegions.size())
+            : INVALID_TEXTURE_ID;
+    }
+
+    auto isValidTextureId(TextureId id) const -> bool {
+        return id >= 0 && static_cast<size_t>(id) < this->textureRegions.size();
     }
 
     auto isTextureLoaded(const string& name) const -> bool {
         return this->textureCache.find(name) != this->textureCache.end();
     }
 
+    /** Queued, in flight or loaded (false once a load fails or is cancelled) */
+    auto isTextureRequested(const string& name) const -> bool {
+        auto lock = lock_guard<mutex>(this->requestedMutex);
+        return this->requestedTextures.contains(name);
+    }
+
     auto getTextureNames() const -> const vector<string>& {
         return this->textureOrder;
     }
@@ -158,16 +449,65 @@ public:
     }
 
     auto getPendingAssetCount() const {
-        auto lock = lock_guard<mutex>(this->pendingMutex);
         return this->pendingAssets.size();
     }
 
+    /**
+     * Limit how much GPU upload work update() does per frame
+     * Stops once either limit is used up; leftovers carry over to the next frame
+     * @param timeBudget Max time spent uploading per frame (0 = unlimited)
+     * @param byteBudget Max decoded bytes uploaded per frame (0 = unlimited)
+     */
+    void setFinalizeBudget(chrono::microseconds timeBudget, size_t byteBudget = 0) {
+        this->finalizeTimeBudget = timeBudget;
+        this->finalizeByteBudget = byteBudget;
+    }
+
+    auto getFinalizeTimeBudget() const {
+        return this->finalizeTimeBudget; 
+    }
+
+    auto getFinalizeByteBudget() const {
+        return this->finalizeByteBudget; 
+    }
+
+    /** Decoded assets waiting for upload (carried over + freshly pushed by workers) */
+    auto getFinalizeBacklog() const {
+        return this->finalizeBacklog.size() + this->getPendingAssetCount();
+    }
+
+    /** Cap on memory held by pooled loose-file read buffers (0 = unlimited) */
+    void setStagingMemoryCap(size_t bytes) {
+        this->stagingBuffers.setCapacity(bytes);
+    }
+
+    auto getStagingMemoryCap() const {
+        return this->stagingBuffers.getCapacity();
+    }
+
+    auto getStagingMemoryInUse() const {
+        return this->stagingBuffers.getInUseBytes();
+    }
+
+    /** Loader pool counters: high I/O queue latency with idle decoders means loading is I/O-bound */
+    auto getIoPoolStats() const -> ThreadPoolStats {
+        return this->ioPool.getStats();
+    }
+
+    auto getDecodePoolStats() const -> ThreadPoolStats {
+        return this->decodePool.getStats();
+    }
+
+    auto getAtlas() const -> const TextureAtlas& {
+        return this->iconAtlas;
+    }
+
     auto getTotalTextureCount() const { 
-        return this->totalTextureCount; 
+        return this->totalTextureCount.load(); 
     }
 
     auto getTotalAssetCount() const { 
-        return this->totalTextureCount; 
+        return this->totalTextureCount.load(); 
     }
 
     auto getLoadedAssetCount() const { 
@@ -178,56 +518,354 @@ public:
         return this->getLoadedAssetCount() == this->getTotalAssetCount();
     }
 
+    /** Byte totals cover manifest-listed textures only (0 if no manifest) */
+    auto getTotalTextureBytes() const {
+        return this->totalTextureBytes.load();
+    }
+
+    auto getLoadedTextureBytes() const {
+        return this->loadedTextureBytes;
+    }
+
+    /** True when every requested texture has a known size, so progress is measured in bytes */
+    auto hasByteProgress() const -> bool {
+        return this->unlistedTextureCount == 0 && this->totalTextureBytes > 0;
+    }
+
     auto getLoadingProgress() const -> float {
+        if (this->hasByteProgress())
+            return static_cast<float>(this->loadedTextureBytes) / static_cast<float>(this->totalTextureBytes.load());
+
         auto total = this->getTotalAssetCount();
         if (total == 0) return 1.0f;
         return static_cast<float>(this->getLoadedAssetCount()) / static_cast<float>(total);
     }
 
 private:
-    auto readFileIntoMemory(const string& fullPath) -> vector<char> {
-        this_thread::sleep_for(chrono::milliseconds(100));  // Simulated delay
+    // Archive index is already sorted by name - no directory walk or sort needed
+    auto listArchivedIcons() const -> vector<string> {
+        auto names = vector<string>();
+        names.reserve(this->iconArchive.getEntryCount());
+        for (auto i = size_t(0); i < this->iconArchive.getEntryCount(); i++)
+            names.emplace_back(this->iconArchive.getName(i));
+        return names;
+    }
+
+    // Manifest is sorted by name - no directory walk or sort needed
+    auto listManifestIcons() const -> vector<string> {
+        auto names = vector<string>();
+        names.reserve(this->iconManifest.getEntries().size());
+        for (const auto& entry : this->iconManifest.getEntries())
+            names.push_back(entry.name);
+        return names;
+    }
+
+    /**
+     * Map the archive and read the manifest (constructor only, before any request or worker
+     * can use them), then size the I/O stage for the read path actually in use:
+     * a few threads for mmap lookups, one per core for blocking loose-file reads
+     */
+    auto openIconSources() -> size_t {
+        if (this->iconManifest.load(ICONS_MANIFEST))
+            this->reserveForManifest();
+
+        if (!this->iconArchive.open(ICONS_ARCHIVE))
+            return max(1u, thread::hardware_concurrency());
+
+        cout << "[AssetManager] Mapped icon archive: " << ICONS_ARCHIVE
+             << " (" << this->iconArchive.getEntryCount() << " entries)" << endl;
+        return MAPPED_IO_THREADS;
+    }
+
+    // Size lookup tables up front so finalizing never reallocates them mid-load
+    void reserveForManifest() {
+        auto count = this->iconManifest.getEntries().size();
+        this->textureCache.reserve(count);
+        this->textureOrder.reserve(count);
+        this->textureRegions.reserve(count);
+        cout << "[AssetManager] Loaded icon manifest: " << count << " entries, "
+             << this->iconManifest.getTotalBytes() << " bytes" << endl;
+    }
+
+    // Development fallback: scan loose files in the icons directory
+    auto listLooseIcons() const -> vector<string> {
+        auto iconsPath = filesystem::path(ICONS_DIR);
+
+        if (!filesystem::exists(iconsPath) || !filesystem::is_directory(iconsPath)) {
+            cerr << "[AssetManager] Warning: " << ICONS_DIR << " directory not found" << endl;
+            return {};
+        }
+
+        // Collect all PNG files
+        auto pngFiles = vector<string>();
+        for (const auto& entry : filesystem::directory_iterator(iconsPath))
+            if (entry.is_regular_file() && entry.path().extension() == ".png")
+                pngFiles.push_back(entry.path().filename().string());
+
+        // Sort files to ensure consistent loading order
+        sort(pngFiles.begin(), pngFiles.end());
+        return pngFiles;
+    }
+
+    // Owned buffer for long-lived data (e.g. fonts, which keep reading from it)
+    auto readFileIntoMemory(const string& fullPath, uint64_t expectedSize = 0) -> vector<char> {
+        return this->readFileInto(fullPath, expectedSize, [](size_t size) { return vector<char>(size); });
+    }
+
+    // Pooled buffer for short-lived staging data (returned to the pool once decoded)
+    auto readFileIntoPool(const string& fullPath, uint64_t expectedSize = 0) -> PooledBuffer {
+        return this->readFileInto(fullPath, expectedSize, [this](size_t size) { return this->stagingBuffers.acquire(size); });
+    }
+
+    // Read a whole file into a buffer made by allocate(size); empty buffer on failure
+    template<typename Allocate>
+    auto readFileInto(const string& fullPath, uint64_t expectedSize, Allocate allocate) -> decltype(allocate(size_t(0))) {
+        // Size known from the manifest: allocate once and skip the seek-to-end probe
+        if (expectedSize > 0) {
+            auto file = ifstream(fullPath, ios::binary);
+            if (!file.is_open()) {
+                cerr << "[AssetManager] Failed to open asset: " << fullPath << endl;
+                return {};
+            }
+
+            auto buffer = allocate(static_cast<size_t>(expectedSize));
+            if (buffer.size() != expectedSize)
+                return {};  // Pool shut down
+            if (file.read(buffer.data(), buffer.size()) && file.peek() == char_traits<char>::eof())
+                return buffer;
+            cerr << "[AssetManager] Size mismatch with manifest (stale?): " << fullPath << endl;
+        }
 
         auto file = ifstream(fullPath, ios::binary | ios::ate);
         if (!file.is_open()) {
-            cerr << "[AssetManager] Failed to open texture: " << fullPath << endl;
+            cerr << "[AssetManager] Failed to open asset: " << fullPath << endl;
             return {};
         }
 
-        auto size = file.tellg();
+        auto size = static_cast<size_t>(file.tellg());
         file.seekg(0, ios::beg);
 
-        auto buffer = vector<char>(size);
+        auto buffer = allocate(size);
+        if (buffer.size() != size)
+            return {};  // Pool shut down
         if (!file.read(buffer.data(), size)) {
-            cerr << "[AssetManager] Failed to read texture: " << fullPath << endl;
+            cerr << "[AssetManager] Failed to read asset: " << fullPath << endl;
             return {};
         }
         return buffer;
     }
 
     void processPendingAssets() {
-        // Process all pending textures loaded in background threads
+        // Process pending textures loaded in background threads, within the frame budget
         // This MUST run on the main thread (SFML OpenGL context requirement)
         //
         // Why not just call loadFromFile() on background threads?
         // OpenGL doesn't allow it. GPU operations must happen on the thread that
         // created the OpenGL context (the main thread). That's why we split loading
-        // into two phases: file I/O (background) and texture creation (main thread).
-        auto lock = lock_guard<mutex>(this->pendingMutex);
-
-        while (!this->pendingAssets.empty()) {
-            auto& pending = this->pendingAssets.front();
-            auto texture = make_shared<Texture>();
-
-            // Create SFML texture from loaded data (main thread only!)
-            if (!texture->loadFromMemory(pending.fileData.data(), pending.fileData.size()))
-                cerr << "[AssetManager] Failed to create texture from data: " << pending.key << endl;
-            else {
-                this->textureCache[pending.key] = texture;
+        // into two phases: file I/O + decode (background) and GPU upload (main thread).
+        this->collectPendingAssets();
+
+        auto start = chrono::steady_clock::now();
+        auto bytesUploaded = size_t(0);
+
+        while (!this->finalizeBacklog.empty()) {
+            auto& pending = this->finalizeBacklog.front();
+            auto size = pending.image.getSize();
+            auto bytes = static_cast<size_t>(size.x) * size.y * 4;
+
+            // Always upload at least one asset per frame so loading can't stall
+            if (bytesUploaded > 0 && this->isFinalizeBudgetSpent(start, bytesUploaded + bytes))
+                break;
+
+            // Upload already-decoded pixels into an atlas page (main thread only!)
+            auto region = this->iconAtlas.add(pending.image);
+            if (!region) {
+                cerr << "[AssetManager] Failed to pack texture into atlas: " << pending.key << endl;
+                this->forgetRequest(pending.key);
+            } else {
+                this->textureCache[pending.key] = static_cast<TextureId>(this->textureRegions.size());
                 this->textureOrder.push_back(pending.key);
+                this->textureRegions.push_back(region);
+                this->loadedTextureBytes += pending.listedSize;
                 cout << "[AssetManager] Finalized texture: " << pending.key << endl;
             }
-            this->pendingAssets.pop();
+            this->finalizeBacklog.pop();
+            this->uploadSlots.release();    // Let a blocked decode worker hand off the next one
+            bytesUploaded += bytes;
+        }
+    }
+
+    auto findOrCreateFontEntry(const string& filename) -> pair<shared_ptr<FontEntry>, bool> {
+        auto lock = lock_guard<mutex>(this->fontMutex);
+        auto& entry = this->fontCache[filename];
+        if (entry)
+            return {entry, false};
+
+        entry = make_shared<FontEntry>();
+        return {entry, true};
+    }
+
+    void queueFontLoad(shared_ptr<FontEntry> entry, const string& filename) {
+        // Entry is captured by value so the task never outlives its state
+        this->ioPool.enqueue([this, entry, filename]() {
+            this->ensureFontLoaded(*entry, filename);
+        }, TaskPriority::High);
+    }
+
+    void ensureFontLoaded(FontEntry& entry, const string& filename) {
+        // Fonts need no OpenGL context to parse (glyph pages are created lazily on draw),
+        // so this is safe on worker threads as well as the main thread
+        call_once(entry.loadOnce, [this, &entry, &filename]() {
+            entry.fileData = this->readFileIntoMemory("assets/fonts/" + filename);
+            if (entry.fileData.empty())
+                return;
+
+            auto font = make_shared<Font>();
+            if (!font->loadFromMemory(entry.fileData.data(), entry.fileData.size())) {
+                cerr << "[AssetManager] Failed to parse font: " << filename << endl;
+                return;
+            }
+            entry.font = move(font);
+            cout << "[AssetManager] Loaded font: " << filename << endl;
+        });
+        entry.ready.store(true, memory_order_release);
+    }
+
+    // Stage 1 (I/O pool): fetch the bytes, then hand off to the decode stage
+    void fetchAndForward(const FetchJob& fetch) {
+        if (this->stopping || !this->claimRequest(fetch.key))
+            return;
+
+        // Zero-copy span into the mapped archive, or read the loose file into memory
+        auto job = DecodeJob{fetch.key, fetch.expectedSize, {}, {}};
+        if (this->iconArchive.isOpen())
+            job.mapped = this->iconArchive.find(fetch.key);
+        if (job.mapped.empty()) {
+            this_thread::sleep_for(chrono::milliseconds(100));  // Simulated delay (disk reads only)
+            job.fileData = this->readFileIntoPool(string(ICONS_DIR) + "/" + fetch.key, fetch.expectedSize);
+        }
+        if (job.mapped.empty() && job.fileData.empty()) {
+            this->forgetRequest(fetch.key);
+            return;
         }
+
+        // Backpressure: wait for room in the decode stage (the permit guarantees a free job slot)
+        if (!this->acquireSlot(this->decodeSlots))
+            return;
+        auto slot = this->claimDecodeJob();
+        this->decodeJobs[slot] = move(job);
+        this->decodePool.enqueue([this, slot]() {
+            this->decodeAndQueue(slot);
+        });
+    }
+
+    auto claimDecodeJob() -> size_t {
+        auto lock = lock_guard<mutex>(this->decodeJobsMutex);
+        auto slot = this->freeDecodeJobs.back();
+        this->freeDecodeJobs.pop_back();
+        return slot;
+    }
+
+    void releaseDecodeJob(size_t slot) {
+        auto lock = lock_guard<mutex>(this->decodeJobsMutex);
+        this->freeDecodeJobs.push_back(slot);   // Never outgrows its initial fill: one entry per slot
+    }
+
+    // Mark a queued request as started; false if it was withdrawn or another copy got it first
+    auto claimRequest(const string& key) -> bool {
+        auto lock = lock_guard<mutex>(this->requestedMutex);
+        auto it = this->requestedTextures.find(key);
+        if (it == this->requestedTextures.end() || it->second.started)
+            return false;
+
+        it->second.started = true;
+        return true;
+    }
+
+    // Stage 2 (decode pool): decode into raw pixels, then hand off to the main thread
+    void decodeAndQueue(size_t slot) {
+        // Decode PNG into raw pixels here, so the main thread only uploads
+        // (sf::Image is plain CPU memory - no OpenGL context needed)
+        auto& job = this->decodeJobs[slot];
+        auto bytes = job.mapped.empty() ? job.fileData.bytes() : job.mapped;
+        auto image = Image();
+        auto decoded = !this->stopping && image.loadFromMemory(bytes.data(), bytes.size());
+
+        // Free the job slot (buffer back to the pool now, not after waiting on the upload stage)
+        auto key = move(job.key);
+        auto listedSize = job.listedSize;
+        job.mapped = {};
+        job.fileData.release();
+        this->releaseDecodeJob(slot);
+        this->decodeSlots.release();
+
+        if (!decoded) {
+            if (!this->stopping) {
+                cerr << "[AssetManager] Failed to decode texture: " << key << endl;
+                this->forgetRequest(key);
+            }
+            return;
+        }
+        auto size = image.getSize();
+
+        // Backpressure: wait for room in the main-thread upload stage
+        if (!this->acquireSlot(this->uploadSlots))
+            return;
+
+        // Add to pending queue (will be processed on main thread)
+        cout << "[AssetManager] Decoded texture data: "
+             << key << " (" << size.x << "x" << size.y << ")" << endl;
+        this->pendingAssets.push({move(key), listedSize, move(image)});
+    }
+
+    // Block until a stage slot frees up; gives up (returns false) once shutting down
+    auto acquireSlot(counting_semaphore<>& slots) -> bool {
+        while (!slots.try_acquire_for(chrono::milliseconds(10)))
+            if (this->stopping)
+                return false;
+        return true;
+    }
+
+    // Drop a failed request so it no longer counts toward progress (and may be retried)
+    void forgetRequest(const string& key) {
+        auto lock = lock_guard<mutex>(this->requestedMutex);
+        auto it = this->requestedTextures.find(key);
+        if (it == this->requestedTextures.end())
+            return;
+        this->uncountRequest(it->second);
+        this->requestedTextures.erase(it);
+    }
+
+    // Add a new request's bytes to the progress totals (requestedMutex held; count added by caller)
+    void countRequest(const LoadRequest& request) {
+        if (request.listed)
+            this->totalTextureBytes += request.listedSize;
+        else
+            this->unlistedTextureCount++;
+    }
+
+    // Remove a request from the progress totals (requestedMutex held)
+    void uncountRequest(const LoadRequest& request) {
+        this->totalTextureCount--;
+        if (request.listed)
+            this->totalTextureBytes -= request.listedSize;
+        else
+            this->unlistedTextureCount--;
+    }
+
+    void collectPendingAssets() {
+        // Lock-free drain; anything pushed mid-drain is picked up next frame
+        while (auto asset = this->pendingAssets.tryPop())
+            this->finalizeBacklog.push(move(*asset));
+    }
+
+    auto isFinalizeBudgetSpent(chrono::steady_clock::time_point start, size_t bytes) const -> bool {
+        if (this->finalizeByteBudget > 0 && bytes > this->finalizeByteBudget)
+            return true;
+        if (MainThreadDispatcher::getInstance().isFrameBudgetSpent())
+            return true;
+
+        auto elapsed = chrono::steady_clock::now() - start;
+        return this->finalizeTimeBudget.count() > 0 && elapsed >= this->finalizeTimeBudget;
     }
 };
@@ -0,0 +1,53 @@
+#pragma once
+#include "AssetManager.hpp"
+#include <SFML/Graphics.hpp>
+#include <initializer_list>
+#include <functional>
+#include <string>
+
+using namespace std;
+using namespace sf;
+
+
+/**
+ * FontBinding - Attaches a shared font to an entity's Text objects once it has loaded
+ *
+ * Polled from onDraw: never waits for the font (AssetManager::tryGetFont), sets it on
+ * every given Text the first time it is available, and tells the caller whether text
+ * can be drawn yet. Main thread only.
+ *
+ * Usage:
+ *   FontBinding font;                                  // member, AssetManager::UI_FONT by default
+ *   if (this->font.bind({&this->label}))               // in onDraw
+ *       window.draw(this->label);
+ */
+class FontBinding {
+private:
+    string filename;
+    FontHandle font;  // Shared, cached by AssetManager; nullptr until loaded
+
+public:
+    explicit FontBinding(string filename = AssetManager::UI_FONT)
+        : filename(move(filename)),
+          font() {
+    }
+
+    /**
+     * true once the font is attached to texts; onBound runs once, right after attaching
+     * (e.g. to lay out text whose bounds need the font)
+     */
+    auto bind(initializer_list<Text*> texts, const function<void()>& onBound = nullptr) -> bool {
+        if (this->font)
+            return true;
+
+        this->font = AssetManager::getInstance().tryGetFont(this->filename);
+        if (!this->font)
+            return false;
+
+        for (auto* text : texts)
+            text->setFont(*this->font);
+        if (onBound)
+            onBound();
+        return true;
+    }
+};
@@ -2,6 +2,7 @@
 #include "Scene.hpp"
 #include "Entity.hpp"
 #include "AssetManager.hpp"
+#include "MainThreadDispatcher.hpp"
 #include <SFML/Graphics.hpp>
 #include <memory>
 
@@ -20,6 +21,9 @@ public:
         : window(VideoMode(width, height), title), activeScene(nullptr) {
 
         this->window.setFramerateLimit(165);
+
+        // Texture uploads run as a recurring main-thread job within the shared frame budget
+        AssetManager::getInstance().scheduleFrameUpdates();
     }
 
     // Scene management (like React Router navigation)
@@ -36,6 +40,13 @@ public:
         }
     }
 
+    // Deferred changeScene(): runs as a main-thread job at the start of a frame
+    void requestSceneChange(shared_ptr<Scene> newScene) {
+        MainThreadDispatcher::getInstance().post([this, newScene]() {
+            this->changeScene(newScene);
+        }, TaskPriority::High);
+    }
+
     // Main game loop with fixed timestep
     void run() {
         auto TICK = seconds(1.f / 60.f);            // 60 updates per second
@@ -43,8 +54,9 @@ public:
         auto lag = Time::Zero;
 
         while (this->window.isOpen()) {
-            // Process pending assets loaded in background (non-blocking)
-            AssetManager::getInstance().update();   // Loads asset from memory into cache
+            // Main-thread jobs within one frame budget: texture uploads, scene changes,
+            // resumed coroutines and anything else posted from other threads
+            MainThreadDispatcher::getInstance().runFrame();
 
             auto elapsed = clock.restart();
             for (lag += elapsed; lag >= TICK; lag -= TICK) {
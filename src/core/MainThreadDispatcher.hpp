@@ -0,0 +1,147 @@
+#pragma once
+#include "../utils/UniqueTask.hpp"
+#include "../utils/TaskQueue.hpp"
+#include "../utils/CancellationToken.hpp"
+#include <array>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <coroutine>
+
+using namespace std;
+
+
+/**
+ * MainThreadDispatcher - Runs closures posted from any thread on the main (GL) thread
+ *
+ * Game::run calls runFrame() once per frame. Work is shared out under one per-frame time
+ * budget, highest priority first (FIFO within a priority); whatever doesn't fit carries
+ * over to the next frame, ahead of newer work of the same priority. The first job of a
+ * frame always runs, so nothing can stall forever.
+ *
+ * Anything posted while a frame runs (including by its own jobs) waits for the next
+ * frame, so a job that re-posts itself runs once per frame (see AssetManager uploads).
+ * Long jobs can check isFrameBudgetSpent() to stop early and re-post the rest.
+ *
+ * Usage:
+ *   dispatcher.post([] { ... });                           // any thread
+ *   dispatcher.post([] { ... }, TaskPriority::High);       // e.g. a scene transition
+ *   co_await nextFrame();                                  // inside a Task<> coroutine
+ */
+class MainThreadDispatcher {
+private:
+    static constexpr auto DEFAULT_FRAME_BUDGET = chrono::microseconds(4000);
+
+    struct Job {
+        UniqueTask task;
+        CancellationToken token;    // Cancelled jobs are dropped without running
+    };
+
+    array<vector<Job>, TASK_PRIORITY_COUNT> posted;     // Guarded by mutex_
+    array<deque<Job>, TASK_PRIORITY_COUNT> ready;       // Main thread only: this frame + carried over
+    mutable mutex mutex_;
+    chrono::microseconds frameBudget;                   // 0 = unlimited
+    chrono::steady_clock::time_point frameDeadline;
+    bool inFrame;
+
+    MainThreadDispatcher()
+        : posted(),
+          ready(),
+          mutex_(),
+          frameBudget(DEFAULT_FRAME_BUDGET),
+          frameDeadline(),
+          inFrame(false) {
+    }
+
+public:
+    static auto getInstance() -> MainThreadDispatcher& {
+        static auto instance = MainThreadDispatcher();
+        return instance;
+    }
+
+    MainThreadDispatcher(const MainThreadDispatcher&) = delete;
+    auto operator=(const MainThreadDispatcher&) -> MainThreadDispatcher& = delete;
+
+    /** Any thread */
+    void post(UniqueTask task, TaskPriority priority = TaskPriority::Normal, CancellationToken token = {}) {
+        auto lock = lock_guard<mutex>(this->mutex_);
+        this->posted[static_cast<size_t>(priority)].push_back({move(task), move(token)});
+    }
+
+    /** Main thread, once per frame */
+    void runFrame() {
+        // Take this frame's arrivals; they queue behind carried-over work of the same priority
+        {
+            auto lock = lock_guard<mutex>(this->mutex_);
+            for (auto lane = size_t(0); lane < TASK_PRIORITY_COUNT; lane++) {
+                for (auto& job : this->posted[lane])
+                    this->ready[lane].push_back(move(job));
+                this->posted[lane].clear();     // Keeps capacity
+            }
+        }
+
+        this->inFrame = true;
+        this->frameDeadline = chrono::steady_clock::now() + this->frameBudget;
+        auto ranAny = false;
+
+        for (auto& lane : this->ready) {
+            while (!lane.empty()) {
+                if (ranAny && this->isFrameBudgetSpent())
+                    break;
+
+                auto job = move(lane.front());
+                lane.pop_front();
+                if (job.token.isCancelled())
+                    continue;
+
+                job.task();
+                ranAny = true;
+            }
+        }
+        this->inFrame = false;
+    }
+
+    /** Whether the current frame's slice is used up (false outside runFrame or with no budget) */
+    auto isFrameBudgetSpent() const -> bool {
+        return this->inFrame
+            && this->frameBudget.count() > 0
+            && chrono::steady_clock::now() >= this->frameDeadline;
+    }
+
+    /** Main-thread time per frame shared by all posted work (0 = unlimited) */
+    void setFrameBudget(chrono::microseconds budget) {
+        this->frameBudget = budget;
+    }
+
+    auto getFrameBudget() const {
+        return this->frameBudget;
+    }
+
+    /** Main thread: posted plus carried-over jobs */
+    auto getPendingCount() const -> size_t {
+        auto count = size_t(0);
+        for (const auto& lane : this->ready)
+            count += lane.size();
+
+        auto lock = lock_guard<mutex>(this->mutex_);
+        for (const auto& lane : this->posted)
+            count += lane.size();
+        return count;
+    }
+};
+
+
+/** co_await nextFrame(): continue the coroutine on the main thread during the next frame */
+inline auto nextFrame(TaskPriority priority = TaskPriority::Normal) {
+    struct Awaiter {
+        TaskPriority priority;
+
+        auto await_ready() const noexcept -> bool { return false; }
+        void await_suspend(coroutine_handle<> handle) {
+            MainThreadDispatcher::getInstance().post([handle]() { handle.resume(); }, this->priority);
+        }
+        void await_resume() const noexcept {}
+    };
+    return Awaiter{priority};
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include "TextureAtlas.hpp"
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <utility>
+
+using namespace std;
+using namespace sf;
+
+
+/**
+ * SpriteBatch - Collects quads into one vertex array per texture page
+ *
+ * Each page is drawn with a single draw call, so the number of draw calls depends on
+ * the number of atlas pages in use, not on the number of cells being rendered.
+ * Untextured (solid color) quads go into their own layer, drawn before any page.
+ *
+ * Usage:
+ *   batch.clear();
+ *   batch.addQuad(cellRect, Color::Red);               // solid background
+ *   batch.addQuad(cellRect, region, Color::White);     // textured overlay
+ *   batch.addQuad(cellRect, region, Color::White, 1, 0);   // ... minus its rightmost 1px
+ *   batch.draw(window);
+ */
+class SpriteBatch {
+private:
+    VertexArray solidLayer;
+    vector<pair<const Texture*, VertexArray>> pageLayers;  // One layer per page, in first-use order
+
+public:
+    SpriteBatch()
+        : solidLayer(Triangles),
+          pageLayers() {
+    }
+
+    // Drop all quads but keep layer storage for reuse next frame
+    void clear() {
+        this->solidLayer.clear();
+        for (auto& [page, vertices] : this->pageLayers)
+            vertices.clear();
+    }
+
+    void addQuad(FloatRect dest, Color color) {
+        appendQuad(this->solidLayer, dest, FloatRect(), color);
+    }
+
+    void addQuad(FloatRect dest, const TextureRegion& region, Color color = Color::White) {
+        if (!region)
+            return;
+
+        auto texRect = FloatRect(
+            static_cast<float>(region.rect.left), static_cast<float>(region.rect.top),
+            static_cast<float>(region.rect.width), static_cast<float>(region.rect.height));
+        appendQuad(this->layerFor(region.page), dest, texRect, color);
+    }
+
+    /**
+     * Textured quad with `trimRight`/`trimBottom` pixels cut off those edges, texture cropped
+     * to match. Pages draw after the solid layer, so this leaves room for a neighbour's
+     * outline spilling into the cell (which would otherwise end up under the icon).
+     */
+    void addQuad(FloatRect dest, const TextureRegion& region, Color color, float trimRight, float trimBottom) {
+        if (!region || dest.width <= trimRight || dest.height <= trimBottom)
+            return;
+
+        auto texRect = FloatRect(
+            static_cast<float>(region.rect.left), static_cast<float>(region.rect.top),
+            region.rect.width * (dest.width - trimRight) / dest.width,
+            region.rect.height * (dest.height - trimBottom) / dest.height);
+        dest.width -= trimRight;
+        dest.height -= trimBottom;
+        appendQuad(this->layerFor(region.page), dest, texRect, color);
+    }
+
+    auto isEmpty() const -> bool {
+        if (this->solidLayer.getVertexCount() > 0)
+            return false;
+        for (const auto& [page, vertices] : this->pageLayers)
+            if (vertices.getVertexCount() > 0)
+                return false;
+        return true;
+    }
+
+    void draw(RenderTarget& target, RenderStates states = RenderStates::Default) const {
+        if (this->solidLayer.getVertexCount() > 0)
+            target.draw(this->solidLayer, states);
+
+        for (const auto& [page, vertices] : this->pageLayers) {
+            if (vertices.getVertexCount() == 0)
+                continue;
+            states.texture = page;
+            target.draw(vertices, states);
+        }
+    }
+
+private:
+    auto layerFor(const Texture* page) -> VertexArray& {
+        for (auto& [layerPage, vertices] : this->pageLayers)
+            if (layerPage == page)
+                return vertices;
+
+        this->pageLayers.emplace_back(page, VertexArray(Triangles));
+        return this->pageLayers.back().second;
+    }
+
+    static void appendQuad(VertexArray& vertices, FloatRect dest, FloatRect tex, Color color) {
+        auto left = dest.left, top = dest.top;
+        auto right = dest.left + dest.width, bottom = dest.top + dest.height;
+        auto texLeft = tex.left, texTop = tex.top;
+        auto texRight = tex.left + tex.width, texBottom = tex.top + tex.height;
+
+        // Two triangles per quad
+        vertices.append(Vertex(Vector2f(left, top), color, Vector2f(texLeft, texTop)));
+        vertices.append(Vertex(Vector2f(right, top), color, Vector2f(texRight, texTop)));
+        vertices.append(Vertex(Vector2f(right, bottom), color, Vector2f(texRight, texBottom)));
+        vertices.append(Vertex(Vector2f(left, top), color, Vector2f(texLeft, texTop)));
+        vertices.append(Vertex(Vector2f(right, bottom), color, Vector2f(texRight, texBottom)));
+        vertices.append(Vertex(Vector2f(left, bottom), color, Vector2f(texLeft, texBottom)));
+    }
+};
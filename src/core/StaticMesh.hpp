@@ -0,0 +1,105 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+using namespace std;
+using namespace sf;
+
+
+/**
+ * StaticMesh - Untextured geometry built once and kept on the GPU
+ *
+ * Collect lines and filled rects, then upload() them into two sf::VertexBuffers with
+ * Static usage; every draw after that is just two buffer draws, no per-frame vertex
+ * work. Without vertex buffer support (or before upload) the CPU copies are drawn instead.
+ *
+ * Rects are drawn before lines. upload() and draw() MUST run on the main thread (OpenGL).
+ *
+ * Usage:
+ *   mesh.addOutline(frameRect, 2.0f, Color::White);
+ *   mesh.addLine(from, to, Color(40, 40, 40));
+ *   mesh.upload();
+ *   mesh.draw(window);     // every frame
+ */
+class StaticMesh {
+private:
+    vector<Vertex> triangles;
+    vector<Vertex> lines;
+    VertexBuffer triangleBuffer;
+    VertexBuffer lineBuffer;
+    bool uploaded;      // Buffers hold the current geometry
+
+public:
+    StaticMesh()
+        : triangles(),
+          lines(),
+          triangleBuffer(Triangles, VertexBuffer::Static),
+          lineBuffer(Lines, VertexBuffer::Static),
+          uploaded(false) {
+    }
+
+    void clear() {
+        this->triangles.clear();
+        this->lines.clear();
+        this->uploaded = false;
+    }
+
+    void addLine(Vector2f from, Vector2f to, Color color) {
+        this->lines.push_back(Vertex(from, color));
+        this->lines.push_back(Vertex(to, color));
+        this->uploaded = false;
+    }
+
+    void addRect(FloatRect rect, Color color) {
+        auto left = rect.left, top = rect.top;
+        auto right = rect.left + rect.width, bottom = rect.top + rect.height;
+
+        // Two triangles per rect
+        this->triangles.push_back(Vertex(Vector2f(left, top), color));
+        this->triangles.push_back(Vertex(Vector2f(right, top), color));
+        this->triangles.push_back(Vertex(Vector2f(right, bottom), color));
+        this->triangles.push_back(Vertex(Vector2f(left, top), color));
+        this->triangles.push_back(Vertex(Vector2f(right, bottom), color));
+        this->triangles.push_back(Vertex(Vector2f(left, bottom), color));
+        this->uploaded = false;
+    }
+
+    // Frame around rect, outside it (same as a RectangleShape with a positive outline)
+    void addOutline(FloatRect rect, float thickness, Color color) {
+        auto outerWidth = rect.width + 2 * thickness;
+        this->addRect(FloatRect(rect.left - thickness, rect.top - thickness, outerWidth, thickness), color);
+        this->addRect(FloatRect(rect.left - thickness, rect.top + rect.height, outerWidth, thickness), color);
+        this->addRect(FloatRect(rect.left - thickness, rect.top, thickness, rect.height), color);
+        this->addRect(FloatRect(rect.left + rect.width, rect.top, thickness, rect.height), color);
+    }
+
+    /** Copy the geometry to the GPU; false if vertex buffers are unavailable (draw() then uses the CPU copy) */
+    auto upload() -> bool {
+        this->uploaded = VertexBuffer::isAvailable()
+            && uploadInto(this->triangleBuffer, this->triangles)
+            && uploadInto(this->lineBuffer, this->lines);
+        return this->uploaded;
+    }
+
+    void draw(RenderTarget& target, RenderStates states = RenderStates::Default) const {
+        if (this->uploaded) {
+            if (this->triangleBuffer.getVertexCount() > 0)
+                target.draw(this->triangleBuffer, states);
+            if (this->lineBuffer.getVertexCount() > 0)
+                target.draw(this->lineBuffer, states);
+            return;
+        }
+
+        if (!this->triangles.empty())
+            target.draw(this->triangles.data(), this->triangles.size(), Triangles, states);
+        if (!this->lines.empty())
+            target.draw(this->lines.data(), this->lines.size(), Lines, states);
+    }
+
+private:
+    static auto uploadInto(VertexBuffer& buffer, const vector<Vertex>& vertices) -> bool {
+        if (vertices.empty())
+            return buffer.create(0);
+        return buffer.create(vertices.size()) && buffer.update(vertices.data());
+    }
+};
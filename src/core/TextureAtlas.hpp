@@ -0,0 +1,109 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+using namespace sf;
+
+
+// Handle to an image packed into an atlas page (page + pixel rect on that page)
+struct TextureRegion {
+    const Texture* page = nullptr;  // Non-owning, owned by TextureAtlas
+    IntRect rect;
+
+    explicit operator bool() const { return this->page != nullptr; }
+};
+
+
+/**
+ * TextureAtlas - Packs small images into a few large texture pages
+ *
+ * Uses simple shelf packing: images are placed left to right on the current row,
+ * starting a new row (shelf) when the row is full and a new page when the page is full.
+ * Each image is uploaded into its sub-rect with Texture::update, so pages grow
+ * incrementally as assets finalize.
+ *
+ * MUST only be used from the main thread (OpenGL context requirement).
+ */
+class TextureAtlas {
+private:
+    static constexpr unsigned PADDING = 1;  // Gap between images to avoid sampling neighbors
+
+    unsigned pageSize;
+    vector<unique_ptr<Texture>> pages;      // unique_ptr keeps page addresses stable
+    unsigned cursorX;
+    unsigned cursorY;
+    unsigned shelfHeight;
+
+public:
+    TextureAtlas(unsigned pageSize = 2048)
+        : pageSize(pageSize),
+          pages(),
+          cursorX(0),
+          cursorY(0),
+          shelfHeight(0) {
+    }
+
+    /**
+     * Copy an image into the atlas
+     * @return Region the image occupies, or an empty region on failure
+     */
+    auto add(const Image& image) -> TextureRegion {
+        auto size = image.getSize();
+        if (size.x == 0 || size.y == 0)
+            return {};
+
+        auto pageSize = min(this->pageSize, Texture::getMaximumSize());
+
+        // Oversized image - give it a dedicated page of its own
+        if (size.x > pageSize || size.y > pageSize) {
+            auto page = this->createPage(size.x, size.y);
+            if (!page)
+                return {};
+            page->update(image, 0, 0);
+            this->cursorY = pageSize;   // Force a fresh page for the next small image
+            return {page, IntRect(0, 0, size.x, size.y)};
+        }
+
+        // Start a new shelf if the image doesn't fit on the current one
+        if (this->cursorX + size.x > pageSize) {
+            this->cursorX = 0;
+            this->cursorY += this->shelfHeight;
+            this->shelfHeight = 0;
+        }
+
+        // Start a new page if the shelf doesn't fit on the current page
+        if (this->pages.empty() || this->cursorY + size.y > pageSize) {
+            if (!this->createPage(pageSize, pageSize))
+                return {};
+            this->cursorX = 0;
+            this->cursorY = 0;
+            this->shelfHeight = 0;
+        }
+
+        auto* page = this->pages.back().get();
+        page->update(image, this->cursorX, this->cursorY);
+        auto rect = IntRect(this->cursorX, this->cursorY, size.x, size.y);
+
+        this->cursorX += size.x + PADDING;
+        this->shelfHeight = max(this->shelfHeight, size.y + PADDING);
+        return {page, rect};
+    }
+
+    auto getPageCount() const { return this->pages.size(); }
+    auto getPage(size_t index) const -> const Texture& { return *this->pages[index]; }
+
+private:
+    auto createPage(unsigned width, unsigned height) -> Texture* {
+        auto page = make_unique<Texture>();
+        if (!page->create(width, height)) {
+            cerr << "[TextureAtlas] Failed to create " << width << "x" << height << " page" << endl;
+            return nullptr;
+        }
+        this->pages.push_back(move(page));
+        return this->pages.back().get();
+    }
+};
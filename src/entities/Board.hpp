@@ -1,37 +1,72 @@
 #pragma once
 #include "../core/Entity.hpp"
 #include "../core/AssetManager.hpp"
+#include "../core/SpriteBatch.hpp"
+#include "../core/StaticMesh.hpp"
 #include "../utils/TetrominoShapes.hpp"
 #include "../game/tetris/TetrisBoard.hpp"
 #include <SFML/Graphics.hpp>
 #include <array>
+#include <vector>
+#include <iostream>
 
 using namespace std;
 using namespace sf;
 using namespace Tetris;
 
+/**
+ * Board - Renders the grid and the locked cells of a TetrisBoard
+ *
+ * Locked cells are batched into one SpriteBatch (color backgrounds in its solid layer,
+ * icon overlays in one layer per atlas page) and rendered into a RenderTexture, so each
+ * frame draws the whole stack as a single quad however full the board is.
+ * The layer is redrawn only when the grid changes (lock, line clear, reset: board
+ * revision), a cell gets a texture, or more textures finish loading while a cell has
+ * one (its ordinal resolves against the loaded count, so it may still be unresolved
+ * or land on a different icon - the same one the falling piece shows).
+ * If the RenderTexture can't be created, the batch is drawn directly instead.
+ */
 class Board : public Entity {
 private:
+    static constexpr auto CELL_OUTLINE = 1.0f;
+
     TetrisBoard* tetrisBoard; // Non-owning pointer to game logic
-    RectangleShape blockShape;
-    RectangleShape blockBackground;  // Solid color background for vibrant colors
-    RectangleShape borderShape;
+    SpriteBatch cellBatch;           // Backgrounds + textured overlays for every locked cell
+    RenderTexture stackLayer;        // cellBatch rendered once per change
+    Sprite stackSprite;
+    bool hasStackLayer;
+    StaticMesh frameMesh;            // Border + grid lines, uploaded once in onCreate
     Vector2f boardPosition;
     bool showBlocks;  // Control visibility of placed blocks
 
-    // Store texture index for each cell (-1 = no texture assigned)
-    array<array<int, BOARD_WIDTH>, BOARD_HEIGHT> textureIndices;
+    // Texture ordinal for each cell (NO_TEXTURE_ORDINAL = no texture assigned),
+    // resolved against the textures loaded so far whenever the batch is built
+    array<array<size_t, BOARD_WIDTH>, BOARD_HEIGHT> cellTextures;
+
+    // What cellBatch was built from
+    bool cellsDirty;
+    unsigned builtRevision;
+    size_t builtTextureCount;       // Loaded textures at build time
+    bool awaitingTextures;          // Some cell has an ordinal, so new loads can change its icon
 
 public:
     Board(TetrisBoard* board)
         : tetrisBoard(board),
-          blockShape(),
-          borderShape(),
+          cellBatch(),
+          stackLayer(),
+          stackSprite(),
+          hasStackLayer(false),
+          frameMesh(),
           boardPosition(),
-          showBlocks(true) {
-        // Initialize all texture indices to -1 (unassigned)
-        for (auto& row : this->textureIndices) {
-            row.fill(-1);
+          showBlocks(true),
+          cellTextures(),
+          cellsDirty(true),
+          builtRevision(0),
+          builtTextureCount(0),
+          awaitingTextures(false) {
+        // Initialize all cell textures to unassigned
+        for (auto& row : this->cellTextures) {
+            row.fill(NO_TEXTURE_ORDINAL);
         }
     }
 
@@ -39,85 +74,59 @@ public:
         // Position board in center-left of screen
         this->boardPosition = Vector2f(50.0f, 50.0f);
 
-        // Setup block background (solid color for vibrant display)
-        this->blockBackground.setSize(Vector2f(BLOCK_SIZE, BLOCK_SIZE));
-        this->blockBackground.setOutlineThickness(1.0f);
-        this->blockBackground.setOutlineColor(Color(0, 0, 0));
-
-        // Setup block shape template (transparent textured layer)
-        this->blockShape.setSize(Vector2f(BLOCK_SIZE, BLOCK_SIZE));
-        this->blockShape.setOutlineThickness(0.0f);
-
-        // Setup border
-        this->borderShape.setSize(Vector2f(BOARD_WIDTH * BLOCK_SIZE, BOARD_HEIGHT * BLOCK_SIZE));
-        this->borderShape.setPosition(this->boardPosition);
-        this->borderShape.setFillColor(Color::Transparent);
-        this->borderShape.setOutlineThickness(2.0f);
-        this->borderShape.setOutlineColor(Color::White);
-    }
+        auto boardRect = FloatRect(this->boardPosition, Vector2f(BOARD_WIDTH * BLOCK_SIZE, BOARD_HEIGHT * BLOCK_SIZE));
+        this->frameMesh.clear();
 
-    void onDraw(RenderWindow& window) override {
-        // Draw border
-        window.draw(this->borderShape);
+        // Border
+        this->frameMesh.addOutline(boardRect, 2.0f, Color::White);
 
-        // Draw grid lines (light grey)
-        auto gridColor = Color(40, 40, 40);  // Light grey
-        auto gridLines = VertexArray(Lines);
+        // Grid lines (light grey)
+        auto gridColor = Color(40, 40, 40);
 
         // Vertical lines
         for (auto x = 0; x <= BOARD_WIDTH; x++) {
-            auto xPos = this->boardPosition.x + x * BLOCK_SIZE;
-            gridLines.append(Vertex(Vector2f(xPos, this->boardPosition.y), gridColor));
-            gridLines.append(Vertex(Vector2f(xPos, this->boardPosition.y + BOARD_HEIGHT * BLOCK_SIZE), gridColor));
+            auto xPos = boardRect.left + x * BLOCK_SIZE;
+            this->frameMesh.addLine(Vector2f(xPos, boardRect.top), Vector2f(xPos, boardRect.top + boardRect.height), gridColor);
         }
 
         // Horizontal lines
         for (auto y = 0; y <= BOARD_HEIGHT; y++) {
-            auto yPos = this->boardPosition.y + y * BLOCK_SIZE;
-            gridLines.append(Vertex(Vector2f(this->boardPosition.x, yPos), gridColor));
-            gridLines.append(Vertex(Vector2f(this->boardPosition.x + BOARD_WIDTH * BLOCK_SIZE, yPos), gridColor));
+            auto yPos = boardRect.top + y * BLOCK_SIZE;
+            this->frameMesh.addLine(Vector2f(boardRect.left, yPos), Vector2f(boardRect.left + boardRect.width, yPos), gridColor);
+        }
+
+        this->frameMesh.upload();
+
+        // Stack layer covers the board plus the cell outlines spilling past its edge
+        auto layerOrigin = this->boardPosition - Vector2f(CELL_OUTLINE, CELL_OUTLINE);
+        auto layerSize = Vector2u(static_cast<unsigned>(boardRect.width + 2 * CELL_OUTLINE),
+                                  static_cast<unsigned>(boardRect.height + 2 * CELL_OUTLINE));
+        this->hasStackLayer = this->stackLayer.create(layerSize.x, layerSize.y);
+        if (this->hasStackLayer) {
+            this->stackSprite.setTexture(this->stackLayer.getTexture(), true);
+            this->stackSprite.setPosition(layerOrigin);
         }
+        else {
+            cerr << "[Board] Failed to create stack layer, drawing cells directly" << endl;
+        }
+        this->cellsDirty = true;
+    }
 
-        window.draw(gridLines);
+    void onDraw(RenderWindow& window) override {
+        // Border and grid: static, already on the GPU
+        this->frameMesh.draw(window);
 
         // Draw placed blocks with persistent textures (only if showBlocks is true)
         if (this->showBlocks && this->tetrisBoard) {
-            auto& assetManager = AssetManager::getInstance();
-            const auto& textureNames = assetManager.getTextureNames();
-            const auto& grid = this->tetrisBoard->getGrid();
-
-            for (auto y = 0; y < BOARD_HEIGHT; y++) {
-                for (auto x = 0; x < BOARD_WIDTH; x++) {
-                    if (grid[y][x] == 0)
-                        continue;
-
-                    auto posX = this->boardPosition.x + x * BLOCK_SIZE;
-                    auto posY = this->boardPosition.y + y * BLOCK_SIZE;
-
-                    auto cellColor = this->getColorFromIndex(grid[y][x]);
-
-                    // Draw solid color background first for vibrant colors
-                    this->blockBackground.setPosition(posX, posY);
-                    this->blockBackground.setFillColor(cellColor);
-                    window.draw(this->blockBackground);
-
-                    // Use stored texture index for this cell
-                    if (this->textureIndices[y][x] >= 0 && !textureNames.empty()) {
-                        auto textureIdx = static_cast<size_t>(this->textureIndices[y][x]);
-                        auto textureName = textureNames[textureIdx % textureNames.size()];
-                        auto texture = assetManager.getTexture(textureName);
-
-                        if (texture) {
-                            // Texture is loaded - draw semi-transparent layer on top
-                            this->blockShape.setPosition(posX, posY);
-                            this->blockShape.setTexture(texture.get());
-                            auto transparentColor = Color(255, 255, 255, 230);
-                            this->blockShape.setFillColor(transparentColor);
-                            window.draw(this->blockShape);
-                        }
-                    }
-                }
+            if (this->needsRebuild()) {
+                this->rebuildCells();
+                this->renderStackLayer();
             }
+
+            if (this->hasStackLayer)
+                window.draw(this->stackSprite);
+            else
+                this->cellBatch.draw(window);
         }
     }
 
@@ -127,18 +136,98 @@ public:
     void setShowBlocks(bool show) { this->showBlocks = show; }
     bool isShowingBlocks() const { return this->showBlocks; }
 
-    // Set texture index for a specific cell (called when piece locks)
-    void setTextureForCell(int x, int y, int textureIndex) {
+    // Set texture ordinal for a specific cell (called when piece locks)
+    void setTextureForCell(int x, int y, size_t textureOrdinal) {
         if (x >= 0 && x < BOARD_WIDTH && y >= 0 && y < BOARD_HEIGHT) {
-            this->textureIndices[y][x] = textureIndex;
+            this->cellTextures[y][x] = textureOrdinal;
+            this->cellsDirty = true;
         }
     }
 
+    /**
+     * Shift cell textures the way TetrisBoard::clearLines shifted the grid
+     * (call after a lock that cleared lines, with TetrisBoard::getLastClearedRows())
+     */
+    void onLinesCleared(const vector<int>& rows) {
+        for (auto row : rows) {
+            if (row < 0 || row >= BOARD_HEIGHT)
+                continue;
+            for (auto y = row; y > 0; y--)
+                this->cellTextures[y] = this->cellTextures[y - 1];
+            this->cellTextures[0].fill(NO_TEXTURE_ORDINAL);
+        }
+        this->cellsDirty = true;
+    }
+
     // Access to underlying game logic (if needed)
     TetrisBoard* getTetrisBoard() { return this->tetrisBoard; }
     const TetrisBoard* getTetrisBoard() const { return this->tetrisBoard; }
 
 private:
+    auto needsRebuild() const -> bool {
+        return this->cellsDirty
+            || this->builtRevision != this->tetrisBoard->getRevision()
+            || (this->awaitingTextures && this->builtTextureCount != AssetManager::getInstance().getLoadedTextureCount());
+    }
+
+    void rebuildCells() {
+        auto& assetManager = AssetManager::getInstance();
+        const auto& grid = this->tetrisBoard->getGrid();
+        auto overlayColor = Color(255, 255, 255, 230);     // Lets the background tint through
+        this->cellBatch.clear();
+        this->awaitingTextures = false;
+
+        for (auto y = 0; y < BOARD_HEIGHT; y++) {
+            for (auto x = 0; x < BOARD_WIDTH; x++) {
+                if (grid[y][x] == 0)
+                    continue;
+
+                auto posX = this->boardPosition.x + x * BLOCK_SIZE;
+                auto posY = this->boardPosition.y + y * BLOCK_SIZE;
+
+                // Black outline (drawn under the fill, spilling 1px outside the cell) + solid color
+                auto outlineRect = FloatRect(posX - CELL_OUTLINE, posY - CELL_OUTLINE,
+                                             BLOCK_SIZE + 2 * CELL_OUTLINE, BLOCK_SIZE + 2 * CELL_OUTLINE);
+                this->cellBatch.addQuad(outlineRect, Color::Black);
+                this->cellBatch.addQuad(FloatRect(posX, posY, BLOCK_SIZE, BLOCK_SIZE), this->getColorFromIndex(grid[y][x]));
+
+                auto ordinal = this->cellTextures[y][x];
+                if (ordinal == NO_TEXTURE_ORDINAL)
+                    continue;
+
+                // Unresolved until a texture loads, and re-resolved whenever the count grows
+                this->awaitingTextures = true;
+                auto region = assetManager.getTexture(assetManager.resolveTextureId(ordinal));
+                if (region) {
+                    // Semi-transparent icon over the cell, short of the outlines the cells to the
+                    // right and below spill into it (icons draw after every outline)
+                    auto trimRight = (x + 1 < BOARD_WIDTH && grid[y][x + 1] != 0) ? CELL_OUTLINE : 0.0f;
+                    auto trimBottom = (y + 1 < BOARD_HEIGHT && grid[y + 1][x] != 0) ? CELL_OUTLINE : 0.0f;
+                    this->cellBatch.addQuad(FloatRect(posX, posY, BLOCK_SIZE, BLOCK_SIZE), region, overlayColor,
+                                            trimRight, trimBottom);
+                }
+            }
+        }
+
+        this->cellsDirty = false;
+        this->builtRevision = this->tetrisBoard->getRevision();
+        this->builtTextureCount = assetManager.getLoadedTextureCount();
+    }
+
+    void renderStackLayer() {
+        if (!this->hasStackLayer)
+            return;
+
+        // Cells are built in window coordinates; shift them into the layer
+        auto states = RenderStates::Default;
+        auto origin = this->stackSprite.getPosition();
+        states.transform.translate(-origin.x, -origin.y);
+
+        this->stackLayer.clear(Color::Transparent);
+        this->cellBatch.draw(this->stackLayer, states);
+        this->stackLayer.display();
+    }
+
     auto getColorFromIndex(int index) const -> Color {
         switch (index) {
             case 1: return Color::Cyan;      // I
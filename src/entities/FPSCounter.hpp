@@ -1,5 +1,6 @@
 #pragma once
 #include "../core/Entity.hpp"
+#include "../core/FontBinding.hpp"
 #include <SFML/Graphics.hpp>
 #include <chrono>
 #include <sstream>
@@ -11,7 +12,7 @@ using namespace std;
 // FPS counter entity that displays frames per second
 class FPSCounter : public Entity {
 private:
-    Font font;
+    FontBinding font;    // Shared UI font, attached once loaded
     Text text;
     std::chrono::steady_clock::time_point lastUpdate;
     int frameCount;
@@ -33,8 +34,6 @@ public:
     }
 
     void onCreate() override {
-        this->font.loadFromFile("assets/fonts/sansation.ttf");
-        this->text.setFont(this->font);
         this->lastUpdate = std::chrono::steady_clock::now();
     }
 
@@ -59,6 +58,7 @@ public:
     }
 
     void onDraw(RenderWindow& window) override {
-        window.draw(this->text);
+        if (this->font.bind({&this->text}))
+            window.draw(this->text);
     }
 };
@@ -1,47 +1,60 @@
 #pragma once
 #include "../core/Entity.hpp"
 #include "../core/AssetManager.hpp"
+#include "../core/SpriteBatch.hpp"
 #include <SFML/Graphics.hpp>
 #include <vector>
-#include <cmath>
+#include <algorithm>
 
 using namespace std;
 using namespace sf;
 
+
+/**
+ * IconScrollDisplay - Grid of loaded icons that scrolls down one row per interval
+ *
+ * Rows live in a flat ring buffer with one extra row for the row scrolling in, so a
+ * scroll step refills one row and moves the ring's head instead of copying the grid.
+ * The cell batch is rebuilt only on a scroll step; between steps the batch is drawn
+ * with a growing vertical offset (smooth scrolling) and clipped to the display area
+ * by a View, so a frame costs the same few draw calls however many icons are loaded.
+ */
 class IconScrollDisplay : public Entity {
 private:
     static constexpr float CELL_SIZE = 30.0f;
     static constexpr int GRID_WIDTH = 10;
     static constexpr int GRID_HEIGHT = 20;
+    static constexpr int RING_ROWS = GRID_HEIGHT + 1;  // Visible rows + the one scrolling in
     static constexpr float SCROLL_INTERVAL = 0.5f; // Half a second
 
-    RectangleShape cellShape;
+    inline static const auto OUTLINE_COLOR = Color(100, 100, 100);
+
+    SpriteBatch cellBatch;   // Outlines + icons, one draw call per atlas page
     Vector2f displayPosition;
 
-    vector<string> textureNames;
-    vector<vector<int>> grid; // Stores texture indices
+    size_t textureCount;
+    vector<TextureId> cells;    // RING_ROWS x GRID_WIDTH texture handles, row-major
+    int incomingRow;            // Ring row just above the top visible row
 
     Time scrollTimer;
-    int currentTextureIndex;
+    TextureId currentTextureIndex;
     bool isActive;
+    bool smoothScrolling;       // Glide between steps instead of jumping a whole row
+    bool batchDirty;
 
 public:
     IconScrollDisplay(Vector2f position)
         : Entity("IconScrollDisplay", position),
-          cellShape(),
+          cellBatch(),
           displayPosition(position),
-          grid(GRID_HEIGHT, vector<int>(GRID_WIDTH, -1)),
+          textureCount(0),
+          cells(RING_ROWS * GRID_WIDTH, INVALID_TEXTURE_ID),
+          incomingRow(0),
           scrollTimer(Time::Zero),
           currentTextureIndex(0),
-          isActive(false) {
-    }
-
-    void onCreate() override {
-        // Setup cell shape for rendering
-        this->cellShape.setSize(Vector2f(CELL_SIZE, CELL_SIZE));
-        this->cellShape.setOutlineThickness(1.0f);
-        this->cellShape.setOutlineColor(Color(100, 100, 100));
-        this->cellShape.setFillColor(Color::White);
+          isActive(false),
+          smoothScrolling(true),
+          batchDirty(true) {
     }
 
     void start() {
@@ -49,17 +62,18 @@ public:
         this->currentTextureIndex = 0;
         this->scrollTimer = Time::Zero;
 
-        // Get all loaded texture names (do this here, after loading is complete)
+        // Snapshot loaded texture count (do this here, after loading is complete)
         auto& assetManager = AssetManager::getInstance();
-        this->textureNames = assetManager.getTextureNames();
+        this->textureCount = assetManager.getLoadedTextureCount();
 
         // Clear grid
-        for (auto& row : this->grid) {
-            row.assign(GRID_WIDTH, -1);
-        }
+        fill(this->cells.begin(), this->cells.end(), INVALID_TEXTURE_ID);
+        this->incomingRow = 0;
 
-        // Fill first row with icons
-        this->fillTopRow();
+        // Fill the top row, then the row that scrolls in above it
+        this->fillRow(this->ringRow(0));
+        this->fillRow(this->incomingRow);
+        this->batchDirty = true;
     }
 
     void stop() {
@@ -70,15 +84,21 @@ public:
         return this->isActive;
     }
 
+    void setSmoothScrolling(bool smooth) { this->smoothScrolling = smooth; }
+    auto isSmoothScrolling() const -> bool { return this->smoothScrolling; }
+
     void onUpdate(Time deltaTime) override {
         if (!this->isActive)
             return;
 
         this->scrollTimer += deltaTime;
 
-        // Scroll every half second
-        if (this->scrollTimer.asSeconds() >= SCROLL_INTERVAL) {
-            this->scrollTimer = Time::Zero;
+        // Scroll every half second (keeping the remainder so smooth motion stays even)
+        auto interval = seconds(SCROLL_INTERVAL);
+        if (this->scrollTimer >= interval) {
+            this->scrollTimer -= interval;
+            if (this->scrollTimer >= interval)
+                this->scrollTimer = Time::Zero;     // Don't race to catch up after a stall
             this->scrollDown();
         }
     }
@@ -87,60 +107,97 @@ public:
         if (!this->isActive)
             return;
 
-        auto& assetManager = AssetManager::getInstance();
-
-        // Draw grid with icons
-        for (int y = 0; y < GRID_HEIGHT; y++) {
-            for (int x = 0; x < GRID_WIDTH; x++) {
-                int textureIdx = this->grid[y][x];
-                if (textureIdx < 0)
-                    continue;
+        if (this->batchDirty)
+            this->rebuildBatch();
 
-                auto posX = this->displayPosition.x + x * CELL_SIZE;
-                auto posY = this->displayPosition.y + y * CELL_SIZE;
+        auto offset = this->smoothScrolling
+            ? min(this->scrollTimer.asSeconds() / SCROLL_INTERVAL, 1.0f) * CELL_SIZE
+            : 0.0f;
 
-                this->cellShape.setPosition(posX, posY);
+        // Clip to the grid (plus the 1px outline spill) so the rows at the edges are cut off
+        auto area = FloatRect(this->displayPosition.x - 1, this->displayPosition.y - 1,
+                              GRID_WIDTH * CELL_SIZE + 2, GRID_HEIGHT * CELL_SIZE + 2);
+        auto previousView = window.getView();
+        window.setView(clipView(window, area));
 
-                // Get texture and draw it (no color tinting - just white/grayscale)
-                if (!this->textureNames.empty()) {
-                    auto textureName = this->textureNames[textureIdx % this->textureNames.size()];
-                    auto texture = assetManager.getTexture(textureName);
+        auto states = RenderStates::Default;
+        states.transform.translate(0.0f, offset);
+        this->cellBatch.draw(window, states);
 
-                    if (texture) {
-                        this->cellShape.setTexture(texture.get());
-                        window.draw(this->cellShape);
-                    }
-                }
-            }
-        }
+        window.setView(previousView);
     }
 
 private:
     void scrollDown() {
-        // Move all rows down by 1
-        for (int y = GRID_HEIGHT - 1; y > 0; y--) {
-            this->grid[y] = this->grid[y - 1];
-        }
-
-        // Clear top row
-        this->grid[0].assign(GRID_WIDTH, -1);
+        // The incoming row becomes the top row; the bottom row's slot is reused as the next incoming row
+        this->incomingRow = (this->incomingRow + RING_ROWS - 1) % RING_ROWS;
+        this->fillRow(this->incomingRow);
+        this->batchDirty = true;
+    }
 
-        // Fill top row with next icons
-        this->fillTopRow();
+    // Ring index of a visible row (0 = top, -1 = the incoming row)
+    auto ringRow(int visibleRow) const -> int {
+        return (this->incomingRow + 1 + visibleRow) % RING_ROWS;
     }
 
-    void fillTopRow() {
-        if (this->textureNames.empty())
+    void fillRow(int ringRow) {
+        auto* row = &this->cells[ringRow * GRID_WIDTH];
+        if (this->textureCount == 0) {
+            fill(row, row + GRID_WIDTH, INVALID_TEXTURE_ID);
             return;
+        }
 
         for (int x = 0; x < GRID_WIDTH; x++) {
-            this->grid[0][x] = this->currentTextureIndex;
+            row[x] = this->currentTextureIndex;
             this->currentTextureIndex++;
 
             // Loop back to beginning when we've shown all textures
-            if (this->currentTextureIndex >= static_cast<int>(this->textureNames.size())) {
+            if (this->currentTextureIndex >= static_cast<int>(this->textureCount)) {
                 this->currentTextureIndex = 0;
             }
         }
     }
+
+    // Batch every row at its resting position; the scroll offset is applied at draw time
+    void rebuildBatch() {
+        auto& assetManager = AssetManager::getInstance();
+        this->cellBatch.clear();
+
+        for (int y = -1; y < GRID_HEIGHT; y++) {
+            const auto* row = &this->cells[this->ringRow(y) * GRID_WIDTH];
+            const auto* rowBelow = (y + 1 < GRID_HEIGHT) ? &this->cells[this->ringRow(y + 1) * GRID_WIDTH] : nullptr;
+            for (int x = 0; x < GRID_WIDTH; x++) {
+                // Get texture and batch it (no color tinting - just white/grayscale)
+                auto region = assetManager.getTexture(row[x]);
+                if (!region)
+                    continue;
+
+                auto posX = this->displayPosition.x + x * CELL_SIZE;
+                auto posY = this->displayPosition.y + y * CELL_SIZE;
+
+                // Grey outline quad spilling 1px outside the cell, icon over the cell short of
+                // the outlines the cells to the right and below spill into it (icons draw last)
+                auto outlineRect = FloatRect(posX - 1, posY - 1, CELL_SIZE + 2, CELL_SIZE + 2);
+                this->cellBatch.addQuad(outlineRect, OUTLINE_COLOR);
+                auto trimRight = (x + 1 < GRID_WIDTH && assetManager.getTexture(row[x + 1])) ? 1.0f : 0.0f;
+                auto trimBottom = (rowBelow && assetManager.getTexture(rowBelow[x])) ? 1.0f : 0.0f;
+                this->cellBatch.addQuad(FloatRect(posX, posY, CELL_SIZE, CELL_SIZE), region, Color::White,
+                                        trimRight, trimBottom);
+            }
+        }
+        this->batchDirty = false;
+    }
+
+    // View showing exactly `area`, placed where `area` is on screen under the window's current view
+    static auto clipView(const RenderWindow& window, FloatRect area) -> View {
+        auto topLeft = window.mapCoordsToPixel(Vector2f(area.left, area.top));
+        auto bottomRight = window.mapCoordsToPixel(Vector2f(area.left + area.width, area.top + area.height));
+        auto windowSize = Vector2f(window.getSize());
+
+        auto view = View(area);
+        view.setViewport(FloatRect(
+            topLeft.x / windowSize.x, topLeft.y / windowSize.y,
+            (bottomRight.x - topLeft.x) / windowSize.x, (bottomRight.y - topLeft.y) / windowSize.y));
+        return view;
+    }
 };
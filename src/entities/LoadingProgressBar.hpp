@@ -1,6 +1,7 @@
 #pragma once
 #include "../core/Entity.hpp"
 #include "../core/AssetManager.hpp"
+#include "../core/FontBinding.hpp"
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <sstream>
@@ -11,7 +12,7 @@ using namespace sf;
 
 class LoadingProgressBar : public Entity {
 private:
-    Font font;
+    FontBinding font;    // Shared UI font, attached once loaded
     Text percentageText;
     Text titleText;
     Text instructionText;
@@ -35,23 +36,17 @@ public:
     }
 
     void onCreate() override {
-        // Setup font
-        this->font.loadFromFile("assets/fonts/sansation.ttf");
-
-        // Setup title text
-        this->titleText.setFont(this->font);
+        // Setup title text (font attached in onDraw once loaded)
         this->titleText.setString("Loading Assets");
         this->titleText.setCharacterSize(16);
         this->titleText.setFillColor(Color::White);
         this->titleText.setPosition(this->position.x, this->position.y - 25);
 
         // Setup percentage text
-        this->percentageText.setFont(this->font);
         this->percentageText.setCharacterSize(16);
         this->percentageText.setFillColor(Color::White);
 
         // Setup instruction text
-        this->instructionText.setFont(this->font);
         this->instructionText.setString("Press Enter to Toggle Icons");
         this->instructionText.setCharacterSize(14);
         this->instructionText.setFillColor(Color(200, 200, 200));
@@ -77,9 +72,14 @@ public:
     }
 
     void onDraw(RenderWindow& window) override {
-        window.draw(this->titleText);
         window.draw(this->barBackground);
         window.draw(this->barForeground);
+
+        // Text waits for the font (then is re-placed with real bounds); the bar draws from the first frame
+        auto texts = {&this->titleText, &this->percentageText, &this->instructionText};
+        if (!this->font.bind(texts, [this]() { this->updateProgress(); }))
+            return;
+        window.draw(this->titleText);
         window.draw(this->percentageText);
 
         // Show instruction text only when loading is complete
@@ -99,10 +99,15 @@ private:
         // Update bar fill
         this->barForeground.setSize(Vector2f(this->barWidth * progress, this->barHeight));
 
-        // Update percentage text
+        // Update percentage text (in MB when the manifest gives us byte sizes)
         auto ss = stringstream();
         ss << fixed << setprecision(0) << (progress * 100.f) << "%";
-        ss << " (" << loaded << "/" << total << ")";
+        if (assetManager.hasByteProgress()) {
+            auto toMB = [](uint64_t bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); };
+            ss << setprecision(1) << " (" << toMB(assetManager.getLoadedTextureBytes())
+               << "/" << toMB(assetManager.getTotalTextureBytes()) << " MB)";
+        } else
+            ss << " (" << loaded << "/" << total << ")";
         this->percentageText.setString(ss.str());
 
         // Position percentage text to the right of the bar
@@ -1,5 +1,6 @@
 #pragma once
 #include "../core/Entity.hpp"
+#include "../core/FontBinding.hpp"
 #include <SFML/Graphics.hpp>
 
 using namespace sf;
@@ -9,7 +10,7 @@ using namespace std;
 // Simple text entity for menu displays
 class MenuText : public Entity {
 private:
-    Font font;
+    FontBinding font;    // Shared UI font, attached once loaded
     Text text;
     bool centered;
 
@@ -26,18 +27,17 @@ public:
         this->text.setPosition(position);
     }
 
-    void onCreate() override {
-        this->font.loadFromFile("assets/fonts/sansation.ttf");
-        this->text.setFont(this->font);
-
-        // Center text if requested
-        if (this->centered) {
-            auto bounds = this->text.getLocalBounds();
-            this->text.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
-        }
+    void onDraw(RenderWindow& window) override {
+        // Nothing to draw until the font has loaded; center once it has (bounds need the font)
+        if (this->font.bind({&this->text}, [this]() { this->center(); }))
+            window.draw(this->text);
     }
 
-    void onDraw(RenderWindow& window) override {
-        window.draw(this->text);
+private:
+    void center() {
+        if (!this->centered)
+            return;
+        auto bounds = this->text.getLocalBounds();
+        this->text.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
     }
 };
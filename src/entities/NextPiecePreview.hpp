@@ -1,5 +1,7 @@
 #pragma once
 #include "../core/Entity.hpp"
+#include "../core/FontBinding.hpp"
+#include "../core/StaticMesh.hpp"
 #include "../utils/TetrominoShapes.hpp"
 #include <SFML/Graphics.hpp>
 
@@ -13,9 +15,9 @@ private:
     ShapeMatrix nextShape;
     Color nextColor;
     RectangleShape blockShape;
-    RectangleShape border;
+    StaticMesh frameMesh;   // Preview box outline, uploaded once
     Text label;
-    Font font;
+    FontBinding font;    // Shared UI font, attached once loaded
 
 public:
     NextPiecePreview(Vector2f position)
@@ -24,26 +26,22 @@ public:
           nextShape(),
           nextColor(),
           blockShape(),
-          border(),
+          frameMesh(),
           label(),
           font() {
     }
 
     void onCreate() override {
-        // Setup label
-        this->font.loadFromFile("assets/fonts/sansation.ttf");
-        this->label.setFont(this->font);
+        // Setup label (font attached in onDraw once loaded)
         this->label.setString("Next:");
         this->label.setCharacterSize(20);
         this->label.setFillColor(Color::White);
         this->label.setPosition(this->position);
 
         // Setup border for preview area
-        this->border.setSize(Vector2f(120, 120));
-        this->border.setPosition(this->position.x, this->position.y + 30);
-        this->border.setFillColor(Color::Transparent);
-        this->border.setOutlineThickness(2.0f);
-        this->border.setOutlineColor(Color::White);
+        this->frameMesh.clear();
+        this->frameMesh.addOutline(FloatRect(this->position.x, this->position.y + 30, 120, 120), 2.0f, Color::White);
+        this->frameMesh.upload();
 
         // Setup block shape
         this->blockShape.setSize(Vector2f(BLOCK_SIZE - 1.0f, BLOCK_SIZE - 1.0f));
@@ -52,8 +50,9 @@ public:
     }
 
     void onDraw(RenderWindow& window) override {
-        window.draw(this->label);
-        window.draw(this->border);
+        if (this->font.bind({&this->label}))
+            window.draw(this->label);
+        this->frameMesh.draw(window);
 
         if (this->nextType == '\0')
             return;
@@ -1,5 +1,6 @@
 #pragma once
 #include "../core/Entity.hpp"
+#include "../core/FontBinding.hpp"
 #include "../game/tetris/TetrisScoring.hpp"
 #include <SFML/Graphics.hpp>
 #include <string>
@@ -11,7 +12,7 @@ class TetrisScoreText : public Entity {
 private:
     TetrisScoring tetrisScoring; // Pure game logic
     Text linesText;
-    Font font;
+    FontBinding font;    // Shared UI font, attached once loaded
 
 public:
     TetrisScoreText(Vector2f position)
@@ -22,9 +23,7 @@ public:
     }
 
     void onCreate() override {
-        // Lines text
-        this->font.loadFromFile("assets/fonts/sansation.ttf");
-        this->linesText.setFont(this->font);
+        // Lines text (font attached in onDraw once loaded)
         this->linesText.setCharacterSize(20);
         this->linesText.setFillColor(Color::White);
         this->linesText.setPosition(this->position);
@@ -33,7 +32,8 @@ public:
     }
 
     void onDraw(RenderWindow& window) override {
-        window.draw(this->linesText);
+        if (this->font.bind({&this->linesText}))
+            window.draw(this->linesText);
     }
 
     void addLines(int linesCleared) {
@@ -1,6 +1,7 @@
 #pragma once
 #include "../core/Entity.hpp"
 #include "../core/AssetManager.hpp"
+#include "../core/SpriteBatch.hpp"
 #include "../utils/TetrominoShapes.hpp"
 #include "../game/tetris/TetrisPiece.hpp"
 #include "Board.hpp"
@@ -13,109 +14,75 @@ using namespace Tetris;
 
 // SFML rendering entity for Tetromino pieces
 // Pure renderer - does not own game logic, just renders from TetrisPiece*
+//
+// Ghost, cell backgrounds and icon overlays share one SpriteBatch (solid layer + one
+// layer per atlas page). The batch and the ghost row are rebuilt only when the piece's
+// placement, the board or the piece texture changes, not every frame.
 class Tetromino : public Entity {
 private:
+    // Everything the ghost row and the batch geometry depend on
+    struct Placement {
+        const TetrisPiece* piece = nullptr;
+        int x = 0;
+        int y = 0;
+        TetrisShape shape = {};
+        unsigned boardRevision = 0;
+
+        auto operator==(const Placement& other) const -> bool = default;
+    };
+
     const TetrisPiece* tetrisPiece;  // Non-owning pointer to game logic
     Color color;
-    RectangleShape blockShape;
-    RectangleShape blockBackground;  // Solid color background for vibrant colors
+    SpriteBatch pieceBatch;          // Ghost + backgrounds + textured overlays
     Board* board;                    // Reference to the game board for rendering position
     Vector2f boardPosition;
 
-    // Store single texture index for this piece (all cells share the same texture)
-    int pieceTextureIndex;
-    inline static size_t nextTextureIndex = 0; // Global counter for unique texture per piece
+    // What pieceBatch was built from
+    Placement builtPlacement;
+    int ghostY;
+    TextureId builtTexture;
+    bool batchDirty;
+
+    // Store single texture for this piece (all cells share the same texture)
+    size_t pieceTextureIndex;                   // Ordinal from the global counter, resolved when drawing
+    inline static size_t nextTextureIndex = 0;  // Global counter for unique texture per piece
 
 public:
     Tetromino(const TetrisPiece* piece, Board* board)
         : tetrisPiece(piece),
           board(board),
           color(piece ? getTetrominoColor(piece->getType()) : Color::White),
-          blockShape(),
+          pieceBatch(),
           boardPosition(),
-          pieceTextureIndex(static_cast<int>(nextTextureIndex++)) {
+          builtPlacement(),
+          ghostY(0),
+          builtTexture(INVALID_TEXTURE_ID),
+          batchDirty(true),
+          pieceTextureIndex(nextTextureIndex++) {
     }
 
     void onCreate() override {
         this->boardPosition = this->board->getBoardPosition();
-
-        // Setup block background (solid color for vibrant display)
-        this->blockBackground.setSize(Vector2f(BLOCK_SIZE, BLOCK_SIZE));
-        this->blockBackground.setOutlineThickness(1.0f);
-        this->blockBackground.setOutlineColor(Color(0, 0, 0));
-
-        // Setup block rendering (transparent textured layer)
-        this->blockShape.setSize(Vector2f(BLOCK_SIZE, BLOCK_SIZE));
-        this->blockShape.setFillColor(this->color);
-        this->blockShape.setOutlineThickness(0.0f);
+        this->batchDirty = true;
     }
 
     void onDraw(RenderWindow& window) override {
         if (!this->tetrisPiece)
             return;
 
-        auto& assetManager = AssetManager::getInstance();
-        const auto& textureNames = assetManager.getTextureNames();
-        const auto& shape = this->tetrisPiece->getShape();
-        auto gridX = this->tetrisPiece->getX();
-        auto gridY = this->tetrisPiece->getY();
+        // Resolved against the textures loaded so far, so it can change while loading
+        auto texture = AssetManager::getInstance().resolveTextureId(this->pieceTextureIndex);
 
-        // Draw ghost piece (shadow) first - without texture or borders
-        auto ghostY = this->tetrisPiece->calculateGhostY();
-        if (ghostY != gridY) {  // Only draw if ghost is below current position
-            auto ghostColor = Color(100, 100, 100, 100);  // Semi-transparent grey
-
-            // Set ghost rendering properties (no borders)
-            this->blockBackground.setOutlineThickness(0.0f);
-            this->blockBackground.setFillColor(ghostColor);
-
-            for (auto y = 0; y < 4; y++) {
-                for (auto x = 0; x < 4; x++) {
-                    if (shape[y][x] == 0) continue;
-
-                    auto px = this->boardPosition.x + (gridX + x) * BLOCK_SIZE;
-                    auto py = this->boardPosition.y + (ghostY + y) * BLOCK_SIZE;
-                    this->blockBackground.setPosition(px, py);
-                    window.draw(this->blockBackground);
-                }
-            }
+        auto placement = this->currentPlacement();
+        if (placement != this->builtPlacement) {
+            this->ghostY = this->tetrisPiece->calculateGhostY();
+            this->batchDirty = true;
         }
 
-        // Set actual piece rendering properties (with borders)
-        this->blockBackground.setOutlineThickness(1.0f);
-        this->blockBackground.setOutlineColor(Color(0, 0, 0));
-
-        // Draw actual tetromino piece with progressive texture loading
-        for (auto y = 0; y < 4; y++) {
-            for (auto x = 0; x < 4; x++) {
-                if (shape[y][x] == 0)
-                    continue;
-
-                auto posX = this->boardPosition.x + (gridX + x) * BLOCK_SIZE;
-                auto posY = this->boardPosition.y + (gridY + y) * BLOCK_SIZE;
-
-                // Draw solid color background first for vibrant colors
-                this->blockBackground.setPosition(posX, posY);
-                this->blockBackground.setFillColor(this->color);
-                window.draw(this->blockBackground);
-
-                // Use piece texture index for all filled cells
-                if (this->pieceTextureIndex < 0 || textureNames.empty())
-                    continue;
-
-                auto textureName = textureNames[static_cast<size_t>(this->pieceTextureIndex) % textureNames.size()];
-                auto texture = assetManager.getTexture(textureName);
-                if (!texture)
-                    continue;
+        if (this->batchDirty || texture != this->builtTexture)
+            this->rebuildBatch(placement, texture);
 
-                // Texture is loaded - draw semi-transparent layer on top
-                this->blockShape.setPosition(posX, posY);
-                this->blockShape.setTexture(texture.get());
-                auto transparentColor = Color(255, 255, 255, 230);
-                this->blockShape.setFillColor(transparentColor);
-                window.draw(this->blockShape);
-            }
-        }
+        this->pieceBatch.draw(window);
     }
 
     // Update the piece being rendered (for when engine spawns new piece)
@@ -123,17 +90,79 @@ public:
         this->tetrisPiece = piece;
         if (piece) {
             this->color = getTetrominoColor(piece->getType());
-            this->pieceTextureIndex = static_cast<int>(nextTextureIndex++); // Assign new texture for new piece
+            this->pieceTextureIndex = nextTextureIndex++; // Assign new texture for new piece
         }
+        this->builtPlacement = Placement();     // Recompute the ghost for the new piece
+        this->batchDirty = true;
     }
 
-    // Get texture index for a specific cell (for transferring to board on lock)
-    auto getTextureIndexForCell(int x, int y) const -> int {
+    // Get texture ordinal for a specific cell (for transferring to board on lock)
+    auto getTextureForCell(int x, int y) const -> size_t {
         if (!this->tetrisPiece || x < 0 || x >= 4 || y < 0 || y >= 4)
-            return -1;
+            return NO_TEXTURE_ORDINAL;
 
-        // Return piece texture index if this cell is filled in the current shape
+        // Return piece texture if this cell is filled in the current shape
         const auto& shape = this->tetrisPiece->getShape();
-        return (shape[y][x] != 0) ? this->pieceTextureIndex : -1;
+        if (shape[y][x] == 0)
+            return NO_TEXTURE_ORDINAL;
+
+        return this->pieceTextureIndex;
+    }
+
+private:
+    auto currentPlacement() const -> Placement {
+        const auto* tetrisBoard = this->board ? this->board->getTetrisBoard() : nullptr;
+        return {
+            this->tetrisPiece,
+            this->tetrisPiece->getX(),
+            this->tetrisPiece->getY(),
+            this->tetrisPiece->getShape(),
+            tetrisBoard ? tetrisBoard->getRevision() : 0u,
+        };
+    }
+
+    void rebuildBatch(const Placement& placement, TextureId texture) {
+        auto region = AssetManager::getInstance().getTexture(texture);
+        this->pieceBatch.clear();
+
+        // Ghost piece (shadow) first - no texture or outline, only if below the piece
+        if (this->ghostY != placement.y) {
+            auto ghostColor = Color(100, 100, 100, 100);  // Semi-transparent grey
+            this->forEachCell(placement, this->ghostY, [&](FloatRect cell, int, int) {
+                this->pieceBatch.addQuad(cell, ghostColor);
+            });
+        }
+
+        // Piece: black outline spilling 1px outside each cell, solid color, then the icon
+        // (short of the outlines the cells to the right and below spill into it)
+        auto overlayColor = Color(255, 255, 255, 230);
+        this->forEachCell(placement, placement.y, [&](FloatRect cell, int x, int y) {
+            this->pieceBatch.addQuad(FloatRect(cell.left - 1, cell.top - 1, cell.width + 2, cell.height + 2), Color::Black);
+            this->pieceBatch.addQuad(cell, this->color);
+            if (!region)
+                return;
+            auto trimRight = (x + 1 < 4 && placement.shape[y][x + 1] != 0) ? 1.0f : 0.0f;
+            auto trimBottom = (y + 1 < 4 && placement.shape[y + 1][x] != 0) ? 1.0f : 0.0f;
+            this->pieceBatch.addQuad(cell, region, overlayColor, trimRight, trimBottom);
+        });
+
+        this->builtPlacement = placement;
+        this->builtTexture = texture;
+        this->batchDirty = false;
+    }
+
+    // fn(cellRect, shapeX, shapeY) for every filled cell of the shape with its top row at gridY
+    template<typename Fn>
+    void forEachCell(const Placement& placement, int gridY, Fn&& fn) const {
+        for (auto y = 0; y < 4; y++) {
+            for (auto x = 0; x < 4; x++) {
+                if (placement.shape[y][x] == 0)
+                    continue;
+
+                auto posX = this->boardPosition.x + (placement.x + x) * BLOCK_SIZE;
+                auto posY = this->boardPosition.y + (gridY + y) * BLOCK_SIZE;
+                fn(FloatRect(posX, posY, BLOCK_SIZE, BLOCK_SIZE), x, y);
+            }
+        }
     }
 };
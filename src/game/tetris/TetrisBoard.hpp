@@ -2,6 +2,7 @@
 #include "TetrisShapes.hpp"
 #include <array>
 #include <algorithm>
+#include <vector>
 
 using namespace std;
 
@@ -11,11 +12,15 @@ private:
     // Board grid: 0 = empty, 1-7 = color index for each piece type
     array<array<int, TETRIS_BOARD_WIDTH>, TETRIS_BOARD_HEIGHT> grid;
     int totalLinesCleared;
+    unsigned revision;      // Bumped on every grid change, so renderers can cache
+    vector<int> lastClearedRows;    // Rows removed by the last clearLines(), in removal order
 
 public:
     TetrisBoard()
         : grid{},
-          totalLinesCleared(0) {
+          totalLinesCleared(0),
+          revision(0),
+          lastClearedRows() {
 
         this->reset();
     }
@@ -25,6 +30,8 @@ public:
         for (auto& row : this->grid)
             row.fill(0);
         this->totalLinesCleared = 0;
+        this->lastClearedRows.clear();
+        this->revision++;
     }
 
     // Check if a position is valid (within bounds and not occupied)
@@ -76,11 +83,13 @@ public:
                     this->grid[boardY][boardX] = colorIndex;
             }
         }
+        this->revision++;
     }
 
     // Check and clear completed lines, return number of lines cleared
     auto clearLines() {
         auto cleared = 0;
+        this->lastClearedRows.clear();
 
         for (auto y = TETRIS_BOARD_HEIGHT - 1; y >= 0;) {
             if (!this->isRowComplete(y))
@@ -112,6 +121,17 @@ public:
         return this->totalLinesCleared;
     }
 
+    // Row indices as each was removed (rows above it shifted down by one, top row emptied),
+    // so per-cell data kept outside the board can be shifted the same way
+    const auto& getLastClearedRows() const {
+        return this->lastClearedRows;
+    }
+
+    // Changes whenever the grid does (place, clear, reset)
+    auto getRevision() const {
+        return this->revision;
+    }
+
     // Bounds checking helpers (public for external use)
     auto isInBounds(int x, int y) const -> bool {
         return x >= 0 && x < TETRIS_BOARD_WIDTH &&
@@ -136,6 +156,8 @@ private:
     // Clear a row by shifting all rows above it down
     void clearRow(int y) {
         this->totalLinesCleared++;
+        this->lastClearedRows.push_back(y);
+        this->revision++;
 
         // Shift all rows above down
         for (auto shiftY = y; shiftY > 0; shiftY--)
@@ -1,6 +1,8 @@
 #pragma once
 #include "../core/Scene.hpp"
 #include "../core/AssetManager.hpp"
+#include "../core/AssetAwaitables.hpp"
+#include "../utils/Task.hpp"
 #include "../game/tetris/TetrisEngine.hpp"
 #include "../entities/Board.hpp"
 #include "../entities/Tetromino.hpp"
@@ -60,42 +62,16 @@ public:
     }
 
     void onCreate() override {
-        // Initialize game engine
-        this->engine.start();
-
-        // Queue all existing textures for background loading
-        AssetManager::getInstance().loadAllTextures();
-
-        // Create board entity (renders engine's board)
-        this->board = make_shared<Board>(&this->engine.getBoard());
-        this->addEntity(this->board);
-
-        // Create UI
-        auto text = "Arrow Keys: Move/Rotate | Space: Hard Drop | Shift: Hold";
-        this->scoreDisplay = make_shared<TetrisScoreText>(Vector2f(400, 50));
-        this->nextPreview = make_shared<NextPiecePreview>(Vector2f(400, 150));
-        this->holdPreview = make_shared<HoldPiecePreview>(Vector2f(400, 320));
-        this->titleText = make_shared<MenuText>("TETRIS", Vector2f(50, 10), 30);
-        this->controlsText = make_shared<MenuText>(text, Vector2f(50, 660), 16);
-        this->loadingProgressBar = make_shared<LoadingProgressBar>(Vector2f(400, 500), 200.f, 30.f);
-
-        this->addEntity(this->scoreDisplay);
-        this->addEntity(this->nextPreview);
-        this->addEntity(this->holdPreview);
-        this->addEntity(this->titleText);
-        this->addEntity(this->controlsText);
-        this->addEntity(this->loadingProgressBar);
+        // Queue assets once per scene (restarts reuse them); the rest runs across frames
+        loadResources().detach();
 
-        // Create icon scroll display (aligned with board)
-        this->iconScrollDisplay = make_shared<IconScrollDisplay>(Vector2f(50, 50));
-        this->addEntity(this->iconScrollDisplay);
-
-        // Create FPS counter (bottom right)
-        this->fpsCounter = make_shared<FPSCounter>(Vector2f(720, 675));
-        this->addEntity(this->fpsCounter);
+        this->startRound();
+    }
 
-        // Sync UI with engine state
-        this->syncVisualState();
+    void onDestroy() override {
+        // Leaving the scene: drop icon loads that haven't started
+        // (loadResources() then finishes once the in-flight ones are in)
+        AssetManager::getInstance().cancelPendingLoads();
     }
 
     void onInput(Event& event) override {
@@ -184,6 +160,59 @@ public:
     }
 
 private:
+    // Start the engine and (re)create every entity; runs on mount and on restart
+    void startRound() {
+        // Initialize game engine
+        this->engine.start();
+
+        // Create board entity (renders engine's board)
+        this->board = make_shared<Board>(&this->engine.getBoard());
+        this->addEntity(this->board);
+
+        // Create UI
+        auto text = "Arrow Keys: Move/Rotate | Space: Hard Drop | Shift: Hold";
+        this->scoreDisplay = make_shared<TetrisScoreText>(Vector2f(400, 50));
+        this->nextPreview = make_shared<NextPiecePreview>(Vector2f(400, 150));
+        this->holdPreview = make_shared<HoldPiecePreview>(Vector2f(400, 320));
+        this->titleText = make_shared<MenuText>("TETRIS", Vector2f(50, 10), 30);
+        this->controlsText = make_shared<MenuText>(text, Vector2f(50, 660), 16);
+        this->loadingProgressBar = make_shared<LoadingProgressBar>(Vector2f(400, 500), 200.f, 30.f);
+
+        this->addEntity(this->scoreDisplay);
+        this->addEntity(this->nextPreview);
+        this->addEntity(this->holdPreview);
+        this->addEntity(this->titleText);
+        this->addEntity(this->controlsText);
+        this->addEntity(this->loadingProgressBar);
+
+        // Create icon scroll display (aligned with board)
+        this->iconScrollDisplay = make_shared<IconScrollDisplay>(Vector2f(50, 50));
+        this->addEntity(this->iconScrollDisplay);
+
+        // Create FPS counter (bottom right)
+        this->fpsCounter = make_shared<FPSCounter>(Vector2f(720, 675));
+        this->addEntity(this->fpsCounter);
+
+        // Sync UI with engine state
+        this->syncVisualState();
+    }
+
+    // Static: a detached coroutine may outlive the scene, so it must not hold `this`
+    static auto loadResources() -> Task<> {
+        auto& assetManager = AssetManager::getInstance();
+
+        // Queue the UI font first so workers pick it up before the icon backlog
+        assetManager.loadFont(AssetManager::UI_FONT);
+
+        // Queue all existing textures for background loading
+        assetManager.loadAllTextures();
+
+        // Suspends here; onCreate carries on and frames keep running
+        co_await texturesLoaded();
+        cout << "[TetrisScene] All " << assetManager.getLoadedTextureCount()
+             << " textures ready - press Enter to view icons" << endl;
+    }
+
     // Synchronize SFML entities with engine state
     void syncVisualState() {
         // Update next piece preview
@@ -218,21 +247,21 @@ private:
     }
 
     void lockPiece() {
-        // Transfer texture indices from active piece to board before locking
+        // Transfer texture ordinals from active piece to board before locking
         if (this->activePiece && this->engine.getActivePiece()) {
             const auto* piece = this->engine.getActivePiece();
             const auto& shape = piece->getShape();
             int gridX = piece->getX();
             int gridY = piece->getY();
 
-            // Transfer texture index for each filled cell
+            // Transfer texture ordinal for each filled cell
             for (auto y = 0; y < 4; y++) {
                 for (auto x = 0; x < 4; x++) {
                     if (shape[y][x] != 0) {
                         int boardX = gridX + x;
                         int boardY = gridY + y;
-                        int textureIdx = this->activePiece->getTextureIndexForCell(x, y);
-                        this->board->setTextureForCell(boardX, boardY, textureIdx);
+                        auto textureOrdinal = this->activePiece->getTextureForCell(x, y);
+                        this->board->setTextureForCell(boardX, boardY, textureOrdinal);
                     }
                 }
             }
@@ -240,9 +269,11 @@ private:
 
         auto linesCleared = this->engine.lockCurrentPiece();
 
-        // Update score if lines were cleared
-        if (linesCleared > 0)
+        // Update score if lines were cleared (and keep cell textures on their rows)
+        if (linesCleared > 0) {
+            this->board->onLinesCleared(this->engine.getBoard().getLastClearedRows());
             this->scoreDisplay->addLines(linesCleared);
+        }
 
         // Check for game over
         if (this->engine.isGameOver()) {
@@ -299,8 +330,8 @@ private:
         this->activePiece = nullptr;
         this->showingIcons = false;
 
-        // Recreate everything
-        this->onCreate();
+        // Recreate everything (assets are already loaded or loading)
+        this->startRound();
     }
 
     void showIconDisplay() {
@@ -0,0 +1,240 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <span>
+#include <vector>
+#include <algorithm>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+using namespace std;
+
+
+/**
+ * Packed asset archive format (written by tools/AssetPacker.cpp)
+ *
+ * Layout (little-endian):
+ *   ArchiveHeader
+ *   ArchiveEntry[entryCount]   - sorted by name, so lookups are a binary search
+ *   name bytes                 - not null-terminated, referenced by nameOffset/nameLength
+ *   data blobs                 - contiguous, each aligned to ARCHIVE_ALIGNMENT
+ *
+ * All offsets are absolute from the start of the file.
+ */
+constexpr char ARCHIVE_MAGIC[8] = {'S', 'T', 'P', 'A', 'K', '\0', '\0', '\0'};
+constexpr uint32_t ARCHIVE_VERSION = 1;
+constexpr uint64_t ARCHIVE_ALIGNMENT = 16;
+
+struct ArchiveHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t entryCount;
+};
+
+struct ArchiveEntry {
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    uint64_t dataOffset;
+    uint64_t dataSize;
+};
+
+
+/**
+ * AssetArchive - Read-only, memory-mapped view of a packed asset archive
+ *
+ * The whole file is mapped once; find() returns zero-copy spans into the mapping,
+ * so loading an asset costs no open/seek/read syscalls.
+ *
+ * Spans stay valid until close() or destruction. The archive is immutable once
+ * opened, so find() may be called from any number of threads concurrently.
+ */
+class AssetArchive {
+private:
+    const char* base;
+    size_t size;
+    const ArchiveEntry* entries;
+    uint32_t entryCount;
+#ifdef _WIN32
+    HANDLE fileHandle;
+    HANDLE mappingHandle;
+#endif
+
+public:
+    AssetArchive()
+        : base(nullptr),
+          size(0),
+          entries(nullptr),
+          entryCount(0)
+#ifdef _WIN32
+          , fileHandle(INVALID_HANDLE_VALUE),
+          mappingHandle(nullptr)
+#endif
+    {}
+
+    ~AssetArchive() { this->close(); }
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    /** Map an archive file; returns false (and stays closed) if missing or malformed */
+    auto open(const string& path) -> bool {
+        this->close();
+        if (!this->map(path))
+            return false;
+
+        if (!this->validate()) {
+            this->close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+        this->unmap();
+        this->base = nullptr;
+        this->size = 0;
+        this->entries = nullptr;
+        this->entryCount = 0;
+    }
+
+    auto isOpen() const -> bool { return this->base != nullptr; }
+    auto getEntryCount() const -> size_t { return this->entryCount; }
+
+    /** Name of the i-th entry (entries are sorted by name) */
+    auto getName(size_t index) const -> string_view {
+        const auto& entry = this->entries[index];
+        return string_view(this->base + entry.nameOffset, entry.nameLength);
+    }
+
+    /** Data of the i-th entry (zero-copy span into the mapping) */
+    auto getData(size_t index) const -> span<const char> {
+        const auto& entry = this->entries[index];
+        return span<const char>(this->base + entry.dataOffset, static_cast<size_t>(entry.dataSize));
+    }
+
+    /** Binary search by name; returns an empty span if not found */
+    auto find(string_view name) const -> span<const char> {
+        auto first = size_t(0);
+        auto last = static_cast<size_t>(this->entryCount);
+
+        while (first < last) {
+            auto mid = first + (last - first) / 2;
+            auto cmp = this->getName(mid).compare(name);
+            if (cmp == 0)
+                return this->getData(mid);
+            if (cmp < 0)
+                first = mid + 1;
+            else
+                last = mid;
+        }
+        return {};
+    }
+
+private:
+    // Bounds-check the header and index so a truncated file can't cause reads past the mapping
+    auto validate() -> bool {
+        if (this->size < sizeof(ArchiveHeader))
+            return false;
+
+        auto header = ArchiveHeader();
+        memcpy(&header, this->base, sizeof(header));
+        if (memcmp(header.magic, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) != 0 || header.version != ARCHIVE_VERSION)
+            return false;
+
+        auto indexEnd = sizeof(ArchiveHeader) + uint64_t(header.entryCount) * sizeof(ArchiveEntry);
+        if (indexEnd > this->size)
+            return false;
+
+        this->entries = reinterpret_cast<const ArchiveEntry*>(this->base + sizeof(ArchiveHeader));
+        this->entryCount = header.entryCount;
+
+        for (auto i = uint32_t(0); i < this->entryCount; i++) {
+            const auto& entry = this->entries[i];
+            if (uint64_t(entry.nameOffset) + entry.nameLength > this->size)
+                return false;
+            if (entry.dataOffset > this->size || entry.dataSize > this->size - entry.dataOffset)
+                return false;
+        }
+        return true;
+    }
+
+#ifdef _WIN32
+    auto map(const string& path) -> bool {
+        this->fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                       OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (this->fileHandle == INVALID_HANDLE_VALUE)
+            return false;
+
+        auto fileSize = LARGE_INTEGER();
+        if (!GetFileSizeEx(this->fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+            this->unmap();
+            return false;
+        }
+
+        this->mappingHandle = CreateFileMappingA(this->fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!this->mappingHandle) {
+            this->unmap();
+            return false;
+        }
+
+        this->base = static_cast<const char*>(MapViewOfFile(this->mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        if (!this->base) {
+            this->unmap();
+            return false;
+        }
+        this->size = static_cast<size_t>(fileSize.QuadPart);
+        return true;
+    }
+
+    void unmap() {
+        if (this->base)
+            UnmapViewOfFile(this->base);
+        if (this->mappingHandle)
+            CloseHandle(this->mappingHandle);
+        if (this->fileHandle != INVALID_HANDLE_VALUE)
+            CloseHandle(this->fileHandle);
+        this->mappingHandle = nullptr;
+        this->fileHandle = INVALID_HANDLE_VALUE;
+    }
+#else
+    auto map(const string& path) -> bool {
+        auto fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat info {};
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+
+        auto* mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);    // Mapping stays valid after the descriptor is closed
+        if (mapping == MAP_FAILED)
+            return false;
+
+        this->base = static_cast<const char*>(mapping);
+        this->size = static_cast<size_t>(info.st_size);
+        return true;
+    }
+
+    void unmap() {
+        if (this->base)
+            munmap(const_cast<char*>(this->base), this->size);
+    }
+#endif
+};
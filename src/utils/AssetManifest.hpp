@@ -0,0 +1,106 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+using namespace std;
+
+
+struct AssetManifestEntry {
+    string name;        // Filename relative to the asset directory
+    uint64_t size;      // File size in bytes
+    uint32_t width;     // Image dimensions (0 if not an image)
+    uint32_t height;
+    uint64_t hash;      // FNV-1a 64-bit hash of the file contents
+};
+
+
+/**
+ * AssetManifest - Precomputed list of assets (written by tools/AssetPacker.cpp)
+ *
+ * Lets the loader know every asset, its size and its dimensions before touching
+ * the asset directory, so it can size buffers up front and report byte-accurate progress.
+ *
+ * Text format, one tab-separated entry per line, sorted by name:
+ *   # STDISCM asset manifest v1
+ *   <name>\t<size>\t<width>\t<height>\t<hash-hex>
+ */
+class AssetManifest {
+private:
+    static constexpr auto HEADER = "# STDISCM asset manifest v1";
+
+    vector<AssetManifestEntry> entries;
+    uint64_t totalBytes;
+
+public:
+    AssetManifest()
+        : entries(),
+          totalBytes(0) {
+    }
+
+    auto load(const string& path) -> bool {
+        auto file = ifstream(path);
+        auto line = string();
+        if (!file.is_open() || !getline(file, line) || line != HEADER)
+            return false;
+
+        auto parsed = vector<AssetManifestEntry>();
+        while (getline(file, line)) {
+            if (line.empty())
+                continue;
+
+            auto ss = istringstream(line);
+            auto entry = AssetManifestEntry();
+            if (!getline(ss, entry.name, '\t') || !(ss >> entry.size >> entry.width >> entry.height >> hex >> entry.hash))
+                return false;
+            parsed.push_back(move(entry));
+        }
+
+        // Writer sorts already; re-sort so hand-edited manifests still binary-search correctly
+        ranges::sort(parsed, {}, &AssetManifestEntry::name);
+
+        this->entries = move(parsed);
+        this->totalBytes = 0;
+        for (const auto& entry : this->entries)
+            this->totalBytes += entry.size;
+        return true;
+    }
+
+    static auto write(const string& path, vector<AssetManifestEntry> entries) -> bool {
+        ranges::sort(entries, {}, &AssetManifestEntry::name);
+
+        auto file = ofstream(path, ios::trunc);
+        if (!file.is_open())
+            return false;
+
+        file << HEADER << '\n';
+        for (const auto& entry : entries)
+            file << entry.name << '\t' << entry.size << '\t' << entry.width << '\t' << entry.height
+                 << '\t' << hex << setw(16) << setfill('0') << entry.hash << dec << '\n';
+        return static_cast<bool>(file);
+    }
+
+    /** Binary search by name; returns nullptr if not listed */
+    auto find(string_view name) const -> const AssetManifestEntry* {
+        auto it = ranges::lower_bound(this->entries, name, {}, &AssetManifestEntry::name);
+        return (it != this->entries.end() && it->name == name) ? &*it : nullptr;
+    }
+
+    auto isLoaded() const -> bool { return !this->entries.empty(); }
+    auto getEntries() const -> const vector<AssetManifestEntry>& { return this->entries; }
+    auto getTotalBytes() const { return this->totalBytes; }
+
+    static auto hashBytes(const char* data, size_t size) -> uint64_t {
+        auto hash = uint64_t(14695981039346656037ull);   // FNV-1a offset basis
+        for (auto i = size_t(0); i < size; i++) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 1099511628211ull;                    // FNV-1a prime
+        }
+        return hash;
+    }
+};
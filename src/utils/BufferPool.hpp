@@ -0,0 +1,219 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <span>
+#include <bit>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+
+class BufferPool;
+
+// Move-only handle to a pooled byte buffer; returns its storage to the pool on destruction
+class PooledBuffer {
+private:
+    BufferPool* pool;
+    vector<char> storage;   // Capacity is the size class, size is the requested size
+    size_t sizeClass;
+
+public:
+    PooledBuffer()
+        : pool(nullptr),
+          storage(),
+          sizeClass(0) {}
+
+    PooledBuffer(BufferPool* pool, vector<char>&& storage, size_t sizeClass)
+        : pool(pool),
+          storage(move(storage)),
+          sizeClass(sizeClass) {}
+
+    ~PooledBuffer() { this->release(); }
+
+    PooledBuffer(const PooledBuffer&) = delete;
+    PooledBuffer& operator=(const PooledBuffer&) = delete;
+
+    PooledBuffer(PooledBuffer&& other) noexcept
+        : pool(other.pool),
+          storage(move(other.storage)),
+          sizeClass(other.sizeClass) {
+        other.pool = nullptr;
+    }
+
+    PooledBuffer& operator=(PooledBuffer&& other) noexcept {
+        if (this != &other) {
+            this->release();
+            this->pool = other.pool;
+            this->storage = move(other.storage);
+            this->sizeClass = other.sizeClass;
+            other.pool = nullptr;
+        }
+        return *this;
+    }
+
+    explicit operator bool() const { return this->pool != nullptr; }
+    auto data() -> char* { return this->storage.data(); }
+    auto data() const -> const char* { return this->storage.data(); }
+    auto size() const { return this->storage.size(); }
+    auto empty() const { return this->storage.empty(); }
+    auto bytes() const -> span<const char> { return span<const char>(this->storage); }
+
+    // Shrink/grow within the size class (never reallocates past the class capacity)
+    void resize(size_t newSize) {
+        if (newSize <= this->storage.capacity())
+            this->storage.resize(newSize);
+    }
+
+    inline void release();
+};
+
+
+/**
+ * BufferPool - Size-classed pool of reusable byte buffers with a memory cap
+ *
+ * Buffers are rounded up to a power-of-two size class and returned to a per-class
+ * free list when released, so steady-state streaming reuses the same allocations
+ * instead of doing one large new/delete per asset.
+ *
+ * The cap bounds all memory the pool holds (buffers in use + idle buffers). When a new
+ * allocation would exceed it, idle buffers of other classes are freed first; if that
+ * is not enough, acquire() blocks until buffers are released (or shutdown() is called).
+ *
+ * Thread-safe: any thread may acquire or release.
+ */
+class BufferPool {
+private:
+    static constexpr size_t MIN_CLASS_SHIFT = 12;   // 4 KB smallest class
+    static constexpr size_t CLASS_COUNT = 20;       // Up to 2 GB
+
+    array<vector<vector<char>>, CLASS_COUNT> freeLists;
+    mutable mutex mutex_;
+    condition_variable cv_;
+    size_t capacityBytes;   // 0 = unlimited
+    size_t heldBytes;       // In use + idle
+    size_t inUseBytes;
+    bool shutdown_;
+
+public:
+    BufferPool(size_t capacityBytes = 0)
+        : freeLists(),
+          mutex_(),
+          cv_(),
+          capacityBytes(capacityBytes),
+          heldBytes(0),
+          inUseBytes(0),
+          shutdown_(false) {}
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /**
+     * Borrow a buffer of at least `size` bytes (size() == size)
+     * Blocks while the cap is reached; returns an empty handle after shutdown()
+     */
+    auto acquire(size_t size) -> PooledBuffer {
+        auto sizeClass = classFor(size);
+        auto classBytes = classSize(sizeClass);
+        auto lock = unique_lock<mutex>(this->mutex_);
+
+        while (true) {
+            if (this->shutdown_ || sizeClass >= CLASS_COUNT)
+                return {};
+
+            // Reuse an idle buffer of the same class (no allocation)
+            auto& freeList = this->freeLists[sizeClass];
+            if (!freeList.empty()) {
+                auto storage = move(freeList.back());
+                freeList.pop_back();
+                this->inUseBytes += classBytes;
+                storage.resize(size);
+                return PooledBuffer(this, move(storage), sizeClass);
+            }
+
+            // Make room by dropping idle buffers of other classes, then allocate
+            this->trimIdle(classBytes);
+            if (this->fitsCap(classBytes)) {
+                this->heldBytes += classBytes;
+                this->inUseBytes += classBytes;
+                lock.unlock();
+
+                auto storage = vector<char>();
+                storage.reserve(classBytes);
+                storage.resize(size);
+                return PooledBuffer(this, move(storage), sizeClass);
+            }
+
+            this->cv_.wait(lock);
+        }
+    }
+
+    void setCapacity(size_t bytes) {
+        {
+            auto lock = lock_guard<mutex>(this->mutex_);
+            this->capacityBytes = bytes;
+        }
+        this->cv_.notify_all();
+    }
+
+    /** Wake every blocked acquire() and make further acquires fail */
+    void shutdown() {
+        {
+            auto lock = lock_guard<mutex>(this->mutex_);
+            this->shutdown_ = true;
+        }
+        this->cv_.notify_all();
+    }
+
+    auto getCapacity() const { auto lock = lock_guard<mutex>(this->mutex_); return this->capacityBytes; }
+    auto getHeldBytes() const { auto lock = lock_guard<mutex>(this->mutex_); return this->heldBytes; }
+    auto getInUseBytes() const { auto lock = lock_guard<mutex>(this->mutex_); return this->inUseBytes; }
+
+private:
+    friend class PooledBuffer;
+
+    void giveBack(vector<char>&& storage, size_t sizeClass) {
+        {
+            auto lock = lock_guard<mutex>(this->mutex_);
+            this->inUseBytes -= classSize(sizeClass);
+            storage.clear();    // Keeps capacity
+            this->freeLists[sizeClass].push_back(move(storage));
+        }
+        this->cv_.notify_all();
+    }
+
+    // A single buffer bigger than the cap is still allowed when the pool holds nothing else
+    auto fitsCap(size_t bytes) const -> bool {
+        return this->capacityBytes == 0
+            || this->heldBytes + bytes <= this->capacityBytes
+            || this->heldBytes == 0;
+    }
+
+    void trimIdle(size_t bytesNeeded) {
+        for (auto sizeClass = size_t(0); sizeClass < CLASS_COUNT && !this->fitsCap(bytesNeeded); sizeClass++) {
+            auto& freeList = this->freeLists[sizeClass];
+            while (!freeList.empty() && !this->fitsCap(bytesNeeded)) {
+                freeList.pop_back();
+                this->heldBytes -= classSize(sizeClass);
+            }
+        }
+    }
+
+    static auto classFor(size_t size) -> size_t {
+        auto rounded = bit_ceil(max(size, size_t(1) << MIN_CLASS_SHIFT));
+        return static_cast<size_t>(countr_zero(rounded)) - MIN_CLASS_SHIFT;
+    }
+
+    static auto classSize(size_t sizeClass) -> size_t {
+        return size_t(1) << (sizeClass + MIN_CLASS_SHIFT);
+    }
+};
+
+inline void PooledBuffer::release() {
+    if (this->pool)
+        this->pool->giveBack(move(this->storage), this->sizeClass);
+    this->pool = nullptr;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <atomic>
+#include <memory>
+
+using namespace std;
+
+
+/**
+ * CancellationToken - Shared flag that lets queued work be withdrawn
+ *
+ * Copies share one state: whoever owns the work keeps a copy and calls cancel(),
+ * queues and tasks holding other copies see isCancelled() and skip it.
+ * A default-constructed token has no state and is never cancelled.
+ *
+ * Usage:
+ *   auto token = CancellationToken::create();
+ *   queue.push(item, TaskPriority::Normal, token);
+ *   token.cancel();    // item is dropped instead of popped
+ */
+class CancellationToken {
+private:
+    shared_ptr<atomic<bool>> state;
+
+public:
+    CancellationToken()
+        : state(nullptr) {
+    }
+
+    static auto create() -> CancellationToken {
+        auto token = CancellationToken();
+        token.state = make_shared<atomic<bool>>(false);
+        return token;
+    }
+
+    void cancel() {
+        if (this->state)
+            this->state->store(true, memory_order_release);
+    }
+
+    auto isCancelled() const -> bool {
+        return this->state && this->state->load(memory_order_acquire);
+    }
+
+    auto canBeCancelled() const -> bool { return this->state != nullptr; }
+
+    // Same token (copies of one create() call)
+    auto operator==(const CancellationToken& other) const -> bool { return this->state == other.state; }
+};
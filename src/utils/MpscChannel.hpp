@@ -0,0 +1,116 @@
+#pragma once
+#include <atomic>
+#include <optional>
+#include <utility>
+#include <memory>
+#include <thread>
+#include <bit>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+
+/**
+ * MpscChannel - Lock-free multi-producer single-consumer queue (bounded ring, Vyukov)
+ *
+ * Items live in a fixed ring of slots allocated once, so pushing never allocates.
+ * Each slot carries a sequence number saying whose turn it is: a producer claims a
+ * slot with one CAS on the enqueue position, fills it and publishes it with a store.
+ * tryPop() is called by a single consumer thread only and never blocks a producer,
+ * nor waits for one.
+ *
+ * tryPush() fails when the ring is full; push() yields until there is room, so size
+ * the channel for the most items callers keep in flight (e.g. a semaphore's count).
+ *
+ * An item whose push is still mid-way (between the claim and the publish) is not
+ * visible yet, and hides the items pushed after it until it completes; the consumer
+ * simply picks them up on its next drain. Fine for per-frame polling.
+ *
+ * Usage:
+ *   auto channel = MpscChannel<Item>(64);
+ *   channel.push(item);                        // any thread
+ *   while (auto item = channel.tryPop()) ...   // consumer thread only
+ */
+template<typename T>
+class MpscChannel {
+private:
+    struct Slot {
+        atomic<size_t> sequence;    // == position: free for that push; == position + 1: filled
+        optional<T> value;
+    };
+
+    unique_ptr<Slot[]> slots;
+    size_t mask;                            // Capacity - 1 (capacity is a power of two)
+    alignas(64) atomic<size_t> enqueuePos;  // Next position to claim (producers)
+    alignas(64) size_t dequeuePos;          // Next position to read (consumer only)
+    atomic<size_t> count;                   // Approximate, for progress reporting
+
+public:
+    /** capacity is rounded up to a power of two */
+    explicit MpscChannel(size_t capacity)
+        : slots(),
+          mask(bit_ceil(max(capacity, size_t(2))) - 1),
+          enqueuePos(0),
+          dequeuePos(0),
+          count(0) {
+        this->slots = make_unique<Slot[]>(this->mask + 1);
+        for (auto i = size_t(0); i <= this->mask; i++)
+            this->slots[i].sequence.store(i, memory_order_relaxed);
+    }
+
+    MpscChannel(const MpscChannel&) = delete;
+    MpscChannel& operator=(const MpscChannel&) = delete;
+
+    /** Any thread; false (value left untouched) if the ring is full */
+    auto tryPush(T&& value) -> bool {
+        auto pos = this->enqueuePos.load(memory_order_relaxed);
+        Slot* slot = nullptr;
+        while (true) {
+            slot = &this->slots[pos & this->mask];
+            auto sequence = slot->sequence.load(memory_order_acquire);
+            auto lag = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (lag == 0) {
+                // Slot is free for this position: claim it (pos is reloaded on failure)
+                if (this->enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+                    break;
+            }
+            else if (lag < 0)
+                return false;   // Consumer hasn't freed this slot yet: full
+            else
+                pos = this->enqueuePos.load(memory_order_relaxed);   // Another producer took it
+        }
+
+        slot->value.emplace(move(value));
+        this->count.fetch_add(1, memory_order_relaxed);
+        slot->sequence.store(pos + 1, memory_order_release);
+        return true;
+    }
+
+    /** Any thread; yields while the ring is full */
+    void push(T value) {
+        while (!this->tryPush(move(value)))
+            this_thread::yield();
+    }
+
+    /** Consumer thread only; nullopt if nothing is (fully) pushed yet */
+    auto tryPop() -> optional<T> {
+        auto& slot = this->slots[this->dequeuePos & this->mask];
+        if (slot.sequence.load(memory_order_acquire) != this->dequeuePos + 1)
+            return nullopt;
+
+        auto value = move(slot.value);
+        slot.value.reset();
+        this->count.fetch_sub(1, memory_order_relaxed);
+
+        // Hand the slot to the push one lap ahead
+        slot.sequence.store(this->dequeuePos + this->mask + 1, memory_order_release);
+        this->dequeuePos++;
+        return value;
+    }
+
+    auto capacity() const -> size_t { return this->mask + 1; }
+    auto size() const -> size_t { return this->count.load(memory_order_relaxed); }
+    auto empty() const -> bool { return this->size() == 0; }
+};
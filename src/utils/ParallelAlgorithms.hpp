@@ -0,0 +1,138 @@
+#pragma once
+#include "ThreadPool.hpp"
+#include "TaskGroup.hpp"
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <functional>
+
+using namespace std;
+
+
+/**
+ * Data-parallel helpers on top of ThreadPool
+ *
+ * The index range is split into chunks of `grain` indices (0 = pick automatically, about
+ * four chunks per thread). Helper tasks and the calling thread all claim chunks from one
+ * atomic counter until none are left, so uneven work balances itself and the caller is
+ * never just blocked waiting. Safe to call from inside a pool task (waiting helps the pool).
+ *
+ * Usage:
+ *   parallelFor(pool, 0, candidates.size(), 0, [&](size_t i) { scores[i] = evaluate(candidates[i]); });
+ *
+ *   auto best = parallelReduce(pool, 0, candidates.size(), 0, 0,
+ *       [&](int acc, size_t i) { return max(acc, scores[i]); },
+ *       [](int a, int b) { return max(a, b); });
+ *
+ *   parallelSort(pool, names.begin(), names.end());
+ */
+namespace parallel_detail {
+    constexpr size_t CHUNKS_PER_THREAD = 4;
+
+    inline auto chooseGrain(const ThreadPool& pool, size_t count, size_t grain) -> size_t {
+        if (grain > 0)
+            return grain;
+        auto chunks = (pool.getThreadCount() + 1) * CHUNKS_PER_THREAD;
+        return max(size_t(1), (count + chunks - 1) / chunks);
+    }
+
+    // Run body(chunkIndex) for every chunk in [0, chunkCount) on the pool and the caller
+    template<typename Body>
+    void forEachChunk(ThreadPool& pool, size_t chunkCount, Body& body) {
+        if (chunkCount == 0)
+            return;
+
+        auto nextChunk = atomic<size_t>(0);
+        auto worker = [&nextChunk, chunkCount, &body]() {
+            for (auto chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++)
+                body(chunk);
+        };
+
+        // One helper per thread is enough: each keeps claiming chunks until they run out
+        auto group = TaskGroup(pool);
+        auto helpers = min(pool.getThreadCount(), chunkCount - 1);
+        for (auto i = size_t(0); i < helpers; i++)
+            group.run(worker);
+
+        worker();
+        group.wait();
+    }
+}
+
+
+/** fn(index) for every index in [begin, end) */
+template<typename Fn>
+void parallelFor(ThreadPool& pool, size_t begin, size_t end, size_t grain, Fn&& fn) {
+    if (begin >= end)
+        return;
+
+    auto count = end - begin;
+    grain = parallel_detail::chooseGrain(pool, count, grain);
+
+    auto body = [&](size_t chunk) {
+        auto first = begin + chunk * grain;
+        auto last = min(end, first + grain);
+        for (auto i = first; i < last; i++)
+            fn(i);
+    };
+    parallel_detail::forEachChunk(pool, (count + grain - 1) / grain, body);
+}
+
+/**
+ * Fold fn(acc, index) over [begin, end), one accumulator per chunk starting at `identity`,
+ * then combine(a, b) the chunk results in index order (so combine need not be commutative)
+ */
+template<typename T, typename Fn, typename Combine>
+auto parallelReduce(ThreadPool& pool, size_t begin, size_t end, size_t grain,
+                    T identity, Fn&& fn, Combine&& combine) -> T {
+    if (begin >= end)
+        return identity;
+
+    auto count = end - begin;
+    grain = parallel_detail::chooseGrain(pool, count, grain);
+    auto chunkCount = (count + grain - 1) / grain;
+    auto partials = vector<T>(chunkCount, identity);
+
+    auto body = [&](size_t chunk) {
+        auto first = begin + chunk * grain;
+        auto last = min(end, first + grain);
+        auto acc = identity;
+        for (auto i = first; i < last; i++)
+            acc = fn(move(acc), i);
+        partials[chunk] = move(acc);
+    };
+    parallel_detail::forEachChunk(pool, chunkCount, body);
+
+    auto result = move(partials[0]);
+    for (auto i = size_t(1); i < chunkCount; i++)
+        result = combine(move(result), move(partials[i]));
+    return result;
+}
+
+/** Sort chunks in parallel, then merge neighbouring runs pairwise in parallel rounds */
+template<typename RandomIt, typename Compare = less<>>
+void parallelSort(ThreadPool& pool, RandomIt first, RandomIt last, Compare comp = Compare(), size_t grain = 0) {
+    auto count = static_cast<size_t>(distance(first, last));
+    grain = max(parallel_detail::chooseGrain(pool, count, grain), size_t(1024));   // Tiny runs aren't worth a task
+    if (count <= grain) {
+        sort(first, last, comp);
+        return;
+    }
+
+    auto at = [&](size_t index) { return first + static_cast<ptrdiff_t>(min(index, count)); };
+
+    auto runCount = (count + grain - 1) / grain;
+    parallelFor(pool, 0, runCount, 1, [&](size_t run) {
+        sort(at(run * grain), at((run + 1) * grain), comp);
+    });
+
+    // Each round merges pairs of sorted runs, doubling the run width
+    for (auto width = grain; width < count; width *= 2) {
+        auto pairCount = (count + 2 * width - 1) / (2 * width);
+        parallelFor(pool, 0, pairCount, 1, [&](size_t pair) {
+            auto start = pair * 2 * width;
+            inplace_merge(at(start), at(start + width), at(start + 2 * width), comp);
+        });
+    }
+}
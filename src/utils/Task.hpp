@@ -0,0 +1,172 @@
+#pragma once
+#include "ThreadPool.hpp"
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+using namespace std;
+
+
+template<typename T>
+class Task;
+
+namespace task_detail {
+    // Shared by Task<T> and Task<void>: continuation, detach flag and exception
+    struct PromiseBase {
+        coroutine_handle<> continuation = nullptr;    // Coroutine awaiting this one
+        bool detached = false;                        // Frees itself on completion
+        exception_ptr exception = nullptr;
+
+        auto initial_suspend() noexcept -> suspend_always { return {}; }
+
+        // Hand control straight to the awaiting coroutine (symmetric transfer, no stack growth)
+        struct FinalAwaiter {
+            auto await_ready() noexcept -> bool { return false; }
+            void await_resume() noexcept {}
+
+            template<typename Promise>
+            auto await_suspend(coroutine_handle<Promise> handle) noexcept -> coroutine_handle<> {
+                auto& promise = handle.promise();
+                if (promise.continuation)
+                    return promise.continuation;
+
+                if (promise.detached) {
+                    // Nobody will ever observe a detached task's exception
+                    if (promise.exception)
+                        terminate();
+                    handle.destroy();
+                }
+                return noop_coroutine();
+            }
+        };
+
+        auto final_suspend() noexcept -> FinalAwaiter { return {}; }
+        void unhandled_exception() { this->exception = current_exception(); }
+    };
+
+    template<typename T>
+    struct Promise : PromiseBase {
+        optional<T> value;
+
+        auto get_return_object() -> Task<T>;
+        void return_value(T result) { this->value.emplace(move(result)); }
+
+        auto takeResult() -> T {
+            if (this->exception)
+                rethrow_exception(this->exception);
+            return move(*this->value);
+        }
+    };
+
+    template<>
+    struct Promise<void> : PromiseBase {
+        auto get_return_object() -> Task<void>;
+        void return_void() {}
+
+        void takeResult() {
+            if (this->exception)
+                rethrow_exception(this->exception);
+        }
+    };
+}
+
+
+/**
+ * Task<T> - Lazily started C++20 coroutine returning T
+ *
+ * A coroutine returning Task<T> does nothing until it is either co_awaited by another
+ * coroutine (which resumes when it finishes and receives its result) or detach()ed
+ * (runs now and frees itself when done). Where it runs in between is decided by
+ * what it awaits:
+ *   co_await resumeOn(pool);            // continue on a ThreadPool worker
+ *   co_await nextFrame();               // continue on the main thread next frame (MainThreadDispatcher.hpp)
+ *   co_await textureLoaded("a.png");    // continue on the main thread once uploaded (AssetAwaitables.hpp)
+ *
+ * A detached coroutine must not outlive anything it references by pointer.
+ */
+template<typename T = void>
+class [[nodiscard]] Task {
+public:
+    using promise_type = task_detail::Promise<T>;
+
+private:
+    coroutine_handle<promise_type> handle;
+
+public:
+    explicit Task(coroutine_handle<promise_type> handle)
+        : handle(handle) {
+    }
+
+    ~Task() {
+        if (this->handle)
+            this->handle.destroy();
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    Task(Task&& other) noexcept
+        : handle(exchange(other.handle, nullptr)) {
+    }
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (this->handle)
+                this->handle.destroy();
+            this->handle = exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+
+    /** Start running now (fire-and-forget); the frame frees itself when the coroutine ends */
+    void detach() && {
+        auto started = exchange(this->handle, nullptr);
+        started.promise().detached = true;
+        started.resume();
+    }
+
+    auto isDone() const -> bool { return !this->handle || this->handle.done(); }
+
+    // co_await task: start it, resume the awaiter when it finishes
+    auto operator co_await() && {
+        struct Awaiter {
+            coroutine_handle<promise_type> handle;
+
+            auto await_ready() const noexcept -> bool { return false; }
+
+            auto await_suspend(coroutine_handle<> awaiting) noexcept -> coroutine_handle<> {
+                this->handle.promise().continuation = awaiting;
+                return this->handle;
+            }
+
+            auto await_resume() -> T { return this->handle.promise().takeResult(); }
+        };
+        return Awaiter{this->handle};
+    }
+};
+
+namespace task_detail {
+    template<typename T>
+    auto Promise<T>::get_return_object() -> Task<T> {
+        return Task<T>(coroutine_handle<Promise<T>>::from_promise(*this));
+    }
+
+    inline auto Promise<void>::get_return_object() -> Task<void> {
+        return Task<void>(coroutine_handle<Promise<void>>::from_promise(*this));
+    }
+}
+
+
+/** co_await resumeOn(pool): continue the coroutine on one of the pool's workers */
+inline auto resumeOn(ThreadPool& pool, TaskPriority priority = TaskPriority::Normal) {
+    struct Awaiter {
+        ThreadPool& pool;
+        TaskPriority priority;
+
+        auto await_ready() const noexcept -> bool { return false; }
+        void await_suspend(coroutine_handle<> handle) { this->pool.enqueue([handle]() { handle.resume(); }, this->priority); }
+        void await_resume() const noexcept {}
+    };
+    return Awaiter{pool, priority};
+}
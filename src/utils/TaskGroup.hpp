@@ -0,0 +1,91 @@
+#pragma once
+#include "ThreadPool.hpp"
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+using namespace std;
+
+
+/**
+ * TaskGroup - Joins exactly the tasks spawned through it (not the whole pool)
+ *
+ * Works as a latch too: add(n) raises the count by hand and done() lowers it, for
+ * work that finishes somewhere other than a run() task (e.g. a main-thread upload).
+ *
+ * Usage:
+ *   auto group = TaskGroup(pool);
+ *   for (auto& item : items)
+ *       group.run([&item] { process(item); });
+ *   group.wait();                  // Helps run pool tasks while waiting
+ *
+ *   if (group.tryWait()) ...       // Non-blocking check, e.g. once per frame
+ *
+ * The destructor waits, so tasks may safely capture the group's scope by reference.
+ */
+class TaskGroup {
+private:
+    ThreadPool& pool;
+    int pending;                    // Guarded by mutex_ so a finished waiter can't race done()
+    mutable mutex mutex_;
+    condition_variable cv_;
+
+public:
+    TaskGroup(ThreadPool& pool)
+        : pool(pool),
+          pending(0),
+          mutex_(),
+          cv_() {
+    }
+
+    ~TaskGroup() { this->wait(); }
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    template<typename F>
+    void run(F&& task) {
+        this->add();
+        this->pool.enqueue([this, task = forward<F>(task)]() mutable {
+            task();
+            this->done();
+        });
+    }
+
+    void add(int count = 1) {
+        auto lock = lock_guard<mutex>(this->mutex_);
+        this->pending += count;
+    }
+
+    void done() {
+        // Notify under the lock: once a waiter sees zero it may destroy the group
+        auto lock = lock_guard<mutex>(this->mutex_);
+        if (--this->pending == 0)
+            this->cv_.notify_all();
+    }
+
+    /** Non-blocking: true once every task in the group has finished */
+    auto tryWait() const -> bool {
+        auto lock = lock_guard<mutex>(this->mutex_);
+        return this->pending == 0;
+    }
+
+    /** Block until every task has finished, running queued pool tasks meanwhile */
+    void wait() {
+        while (!this->waitFor(chrono::milliseconds(1))) {}
+    }
+
+    /** Block up to `timeout`; returns tryWait() */
+    auto waitFor(chrono::microseconds timeout) -> bool {
+        auto deadline = chrono::steady_clock::now() + timeout;
+
+        // Help first: our tasks may be queued behind others, and we may be a pool worker
+        while (!this->tryWait() && chrono::steady_clock::now() < deadline) {
+            if (!this->pool.runPendingTask())
+                break;
+        }
+
+        // Nothing left to help with; sleep until done or timed out
+        auto lock = unique_lock<mutex>(this->mutex_);
+        return this->cv_.wait_until(lock, deadline, [this] { return this->pending == 0; });
+    }
+};
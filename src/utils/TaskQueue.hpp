@@ -1,85 +1,342 @@
 #pragma once
-#include <queue>
+#include "CancellationToken.hpp"
+#include <array>
+#include <vector>
 #include <mutex>
+#include <atomic>
 #include <condition_variable>
 #include <optional>
+#include <algorithm>
+#include <cstdint>
 
 using namespace std;
 
 
+enum class TaskPriority : uint8_t {
+    High,           // Needed now (e.g. on screen this frame)
+    Normal,
+    Background,     // Bulk fill; runs when nothing else is queued
+};
+constexpr size_t TASK_PRIORITY_COUNT = 3;
+
+
+/**
+ * TaskQueue - Thread-safe queue with priority lanes and cancellation
+ *
+ * Each priority has its own FIFO lane; pops take from the highest non-empty lane.
+ * Items pushed with a CancellationToken are dropped (never returned) once the token
+ * is cancelled: lazily when a pop reaches them, or eagerly via dropCancelled().
+ *
+ * Lanes are rings that only grow, so a steady stream of push/pop reuses the same
+ * slots instead of allocating. pushBulk()/popBulk() move many items per lock.
+ *
+ * Optional capacity (0 = unbounded): push() blocks while full, tryPush() fails instead.
+ */
 template<typename T>
 class TaskQueue {
 private:
-    queue<T> queue_;
+    struct Entry {
+        T item;
+        CancellationToken token;
+    };
+
+    struct Lane {
+        vector<optional<Entry>> ring;
+        size_t head = 0;        // Index of the front entry
+        size_t count = 0;
+    };
+
+    array<Lane, TASK_PRIORITY_COUNT> lanes_;
+    size_t count_;          // Across all lanes, including cancelled entries not yet dropped
+    size_t capacity_;       // 0 = unbounded
     mutable mutex mutex_;  // mutable for const methods
-    condition_variable cv_;
+    condition_variable cv_;         // Signaled when items arrive
+    condition_variable spaceCv_;    // Signaled when a bounded queue frees room
     bool shutdown_;
+    mutable atomic<uint64_t> contended_;    // Lock acquisitions that found the mutex taken
 
 public:
-    TaskQueue()
-        : queue_(),
+    TaskQueue(size_t capacity = 0)
+        : lanes_(),
+          count_(0),
+          capacity_(capacity),
           mutex_(),
           cv_(),
-          shutdown_(false) {}
+          spaceCv_(),
+          shutdown_(false),
+          contended_(0) {}
 
     ~TaskQueue() = default;
     TaskQueue(const TaskQueue&) = delete;
     TaskQueue& operator=(const TaskQueue&) = delete;
 
-    void push(T item) {
+    /** Blocks while a bounded queue is full; returns false (item dropped) if shut down meanwhile */
+    auto push(T item, TaskPriority priority = TaskPriority::Normal, CancellationToken token = {}) -> bool {
+        {
+            auto lock = this->lockQueue();
+            this->spaceCv_.wait(lock, [this] { return this->hasRoom() || this->shutdown_; });
+            if (!this->hasRoom())
+                return false;
+            this->pushBack(this->lanes_[static_cast<size_t>(priority)], {move(item), move(token)});
+        }
+        this->cv_.notify_one();
+        return true;
+    }
+
+    /** Never blocks; on failure (full) `item` is left untouched */
+    auto tryPush(T&& item, TaskPriority priority = TaskPriority::Normal, CancellationToken token = {}) -> bool {
         {
-            auto lock = lock_guard<mutex>(this->mutex_);
-            this->queue_.push(move(item));
+            auto lock = this->lockQueue();
+            if (!this->hasRoom())
+                return false;
+            this->pushBack(this->lanes_[static_cast<size_t>(priority)], {move(item), move(token)});
         }
         this->cv_.notify_one();
+        return true;
+    }
+
+    /**
+     * Push every item into one lane, taking the lock once per run of free room
+     * (once in total when unbounded). Blocks while full like push().
+     * @return Number of items pushed (fewer than items.size() only if shut down meanwhile)
+     */
+    auto pushBulk(vector<T>&& items, TaskPriority priority = TaskPriority::Normal, CancellationToken token = {}) -> size_t {
+        auto& lane = this->lanes_[static_cast<size_t>(priority)];
+        auto pushed = size_t(0);
+
+        while (pushed < items.size()) {
+            auto added = size_t(0);
+            {
+                auto lock = this->lockQueue();
+                this->spaceCv_.wait(lock, [this] { return this->hasRoom() || this->shutdown_; });
+                while (pushed < items.size() && this->hasRoom()) {
+                    this->pushBack(lane, {move(items[pushed]), token});
+                    pushed++;
+                    added++;
+                }
+            }
+            if (added == 0)
+                break;  // Shut down while full
+            this->notifyPushed(added);
+        }
+        return pushed;
+    }
+
+    /**
+     * Move up to maxItems into `out` under one lock, blocking until at least one is available
+     * @return Number of items appended (0 only after shutdown)
+     */
+    auto popBulk(vector<T>& out, size_t maxItems) -> size_t {
+        auto lock = this->lockQueue();
+        auto popped = size_t(0);
+
+        while (popped == 0) {
+            this->cv_.wait(lock, [this] { return this->count_ > 0 || this->shutdown_; });
+            if (this->shutdown_ && this->count_ == 0)
+                return 0;
+
+            auto before = this->count_;
+            popped = this->popLiveInto(out, maxItems);
+            auto freed = before - this->count_;  // Includes cancelled entries skipped on the way
+            if (freed > 0) {
+                lock.unlock();
+                this->notifyRoom(freed);
+                lock.lock();
+            }
+        }
+        return popped;
+    }
+
+    /** Non-blocking popBulk(); returns 0 if nothing is queued */
+    auto tryPopBulk(vector<T>& out, size_t maxItems) -> size_t {
+        auto popped = size_t(0);
+        auto freed = size_t(0);
+        {
+            auto lock = this->lockQueue();
+            auto before = this->count_;
+            popped = this->popLiveInto(out, maxItems);
+            freed = before - this->count_;  // Includes cancelled entries skipped on the way
+        }
+        this->notifyRoom(freed);
+        return popped;
     }
 
     auto pop() -> optional<T> {
-        auto lock = unique_lock<mutex>(this->mutex_);
+        auto lock = this->lockQueue();
 
-        // Wait until queue has items or shutdown is signaled
-        this->cv_.wait(lock, [this] { return !this->queue_.empty() || this->shutdown_; });
+        while (true) {
+            // Wait until queue has items or shutdown is signaled
+            this->cv_.wait(lock, [this] { return this->count_ > 0 || this->shutdown_; });
 
-        // If shutdown and no items, return nullopt
-        if (this->shutdown_ && this->queue_.empty())
-            return nullopt;
+            // If shutdown and no items, return nullopt
+            if (this->shutdown_ && this->count_ == 0)
+                return nullopt;
 
-        auto item = move(this->queue_.front());
-        this->queue_.pop();
-        return item;
+            // Everything left may have been cancelled; wait again if so
+            auto before = this->count_;
+            auto item = this->popLive();
+            auto freed = before - this->count_;
+            lock.unlock();
+            this->notifyRoom(freed);
+            if (item)
+                return item;
+            lock.lock();
+        }
     }
 
-    /** Returns nullopt if queue is empty. */
+    /** Returns nullopt if queue is empty (or holds only cancelled items). */
     auto tryPop() -> optional<T> {
-        auto lock = lock_guard<mutex>(this->mutex_);
-        if (this->queue_.empty())
-            return nullopt;
-
-        auto item = move(this->queue_.front());
-        this->queue_.pop();
+        auto item = optional<T>();
+        auto freed = size_t(0);
+        {
+            auto lock = this->lockQueue();
+            auto before = this->count_;
+            item = this->popLive();
+            freed = before - this->count_;  // Includes cancelled entries skipped on the way
+        }
+        this->notifyRoom(freed);
         return item;
     }
 
+    /** Destroy every cancelled item now instead of when a pop reaches it; returns how many */
+    auto dropCancelled() -> size_t {
+        auto lock = this->lockQueue();
+        auto dropped = size_t(0);
+
+        for (auto& lane : this->lanes_) {
+            auto kept = size_t(0);
+            for (auto i = size_t(0); i < lane.count; i++) {
+                auto& slot = lane.ring[(lane.head + i) % lane.ring.size()];
+                if (slot->token.isCancelled()) {
+                    slot.reset();
+                    dropped++;
+                    continue;
+                }
+                // Compact survivors toward the front, keeping FIFO order
+                auto& target = lane.ring[(lane.head + kept) % lane.ring.size()];
+                if (&target != &slot) {
+                    target = move(slot);
+                    slot.reset();
+                }
+                kept++;
+            }
+            lane.count = kept;
+        }
+        this->count_ -= dropped;
+        lock.unlock();
+        this->notifyRoom(dropped);
+        return dropped;
+    }
+
     void shutdown() {
         {
-            auto lock = lock_guard<mutex>(this->mutex_);
+            auto lock = this->lockQueue();
             this->shutdown_ = true;
         }
         this->cv_.notify_all();
+        this->spaceCv_.notify_all();
     }
 
     bool empty() const {
-        auto lock = lock_guard<mutex>(this->mutex_);
-        return this->queue_.empty();
+        auto lock = this->lockQueue();
+        return this->count_ == 0;
     }
 
     auto size() const {
-        auto lock = lock_guard<mutex>(this->mutex_);
-        return static_cast<int>(this->queue_.size());
+        auto lock = this->lockQueue();
+        return static_cast<int>(this->count_);
     }
 
+    auto getCapacity() const { return this->capacity_; }
+
+    /** How often a thread had to wait for another one to release the queue's lock */
+    auto getContentionCount() const -> uint64_t { return this->contended_.load(memory_order_relaxed); }
+
     auto isShutdown() const {
-        auto lock = lock_guard<mutex>(this->mutex_);
+        auto lock = this->lockQueue();
         return this->shutdown_;
     }
+
+private:
+    // try_lock first so contention can be counted at no cost when the lock is free
+    auto lockQueue() const -> unique_lock<mutex> {
+        auto lock = unique_lock<mutex>(this->mutex_, try_to_lock);
+        if (!lock.owns_lock()) {
+            this->contended_.fetch_add(1, memory_order_relaxed);
+            lock.lock();
+        }
+        return lock;
+    }
+
+    // Front of the highest-priority lane, skipping (and destroying) cancelled entries
+    auto popLive() -> optional<T> {
+        for (auto& lane : this->lanes_) {
+            while (lane.count > 0) {
+                auto entry = this->popFront(lane);
+                if (!entry.token.isCancelled())
+                    return move(entry.item);
+            }
+        }
+        return nullopt;
+    }
+
+    auto popLiveInto(vector<T>& out, size_t maxItems) -> size_t {
+        auto popped = size_t(0);
+        while (popped < maxItems) {
+            auto item = this->popLive();
+            if (!item)
+                break;
+            out.push_back(move(*item));
+            popped++;
+        }
+        return popped;
+    }
+
+    // Cancelled entries still take room until dropped, so a full queue is never overfilled
+    auto hasRoom() const -> bool {
+        return this->capacity_ == 0 || this->count_ < this->capacity_;
+    }
+
+    void notifyPushed(size_t count) {
+        if (count == 1)
+            this->cv_.notify_one();
+        else if (count > 1)
+            this->cv_.notify_all();
+    }
+
+    void notifyRoom(size_t count) {
+        if (this->capacity_ == 0 || count == 0)
+            return;
+        if (count == 1)
+            this->spaceCv_.notify_one();
+        else
+            this->spaceCv_.notify_all();
+    }
+
+    void pushBack(Lane& lane, Entry&& entry) {
+        if (lane.count == lane.ring.size())
+            this->grow(lane);
+        lane.ring[(lane.head + lane.count) % lane.ring.size()].emplace(move(entry));
+        lane.count++;
+        this->count_++;
+    }
+
+    auto popFront(Lane& lane) -> Entry {
+        auto& slot = lane.ring[lane.head];
+        auto entry = move(*slot);
+        slot.reset();
+        lane.head = (lane.head + 1) % lane.ring.size();
+        lane.count--;
+        this->count_--;
+        return entry;
+    }
+
+    // Double the ring, unwrapping entries so the front is at index 0
+    void grow(Lane& lane) {
+        auto bigger = vector<optional<Entry>>(max(size_t(16), lane.ring.size() * 2));
+        for (auto i = size_t(0); i < lane.count; i++)
+            bigger[i] = move(lane.ring[(lane.head + i) % lane.ring.size()]);
+        lane.ring = move(bigger);
+        lane.head = 0;
+    }
 };
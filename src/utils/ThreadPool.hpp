@@ -1,35 +1,214 @@
 #pragma once
 #include "TaskQueue.hpp"
+#include "WorkStealingDeque.hpp"
+#include "UniqueTask.hpp"
 #include <vector>
+#include <memory>
+#include <algorithm>
+#include <iterator>
 #include <thread>
 #include <functional>
+#include <future>
+#include <type_traits>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <array>
+#include <chrono>
+#include <bit>
+#include <cstdint>
 #include <iostream>
 
 using namespace std;
 
 
+/**
+ * ThreadPoolStats - Snapshot of a ThreadPool's counters (ThreadPool::getStats())
+ *
+ * Everything counts from pool creation. Times are log2 histograms in microseconds:
+ * bucket 0 is under 1us, bucket i is [2^(i-1), 2^i) us, and the last bucket also
+ * holds everything longer.
+ *
+ * Reading it: high queueLatency with low utilization means tasks wait on something
+ * other than CPU (e.g. I/O inside tasks); high latency with workers near 100% means
+ * the pool is starved for threads; high injectionContention relative to tasksRun means
+ * threads spend their time fighting over the shared queue, not working. failedSteals
+ * counts idle periods (a thread ran out of work and found none to steal), not retries,
+ * so failedSteals close to tasksRun means work arrives in trickles, not starvation.
+ */
+struct ThreadPoolStats {
+    static constexpr size_t HISTOGRAM_BUCKETS = 24;     // Last bucket starts at ~4s
+    using Histogram = array<uint64_t, HISTOGRAM_BUCKETS>;
+
+    struct WorkerStats {
+        uint64_t tasksRun = 0;
+        uint64_t steals = 0;
+        uint64_t failedSteals = 0;                      // Idle periods that began with a fruitless steal sweep
+        chrono::nanoseconds busyTime = chrono::nanoseconds(0);
+        chrono::nanoseconds idleTime = chrono::nanoseconds(0);     // Searching, yielding or asleep
+
+        auto utilization() const -> double {
+            auto total = (this->busyTime + this->idleTime).count();
+            return total > 0 ? static_cast<double>(this->busyTime.count()) / total : 0.0;
+        }
+    };
+
+    vector<WorkerStats> workers;
+    WorkerStats external;           // Tasks run by outside threads helping out (TaskGroup waits); no idle time
+    uint64_t tasksEnqueued = 0;
+    uint64_t tasksRun = 0;
+    uint64_t steals = 0;
+    uint64_t failedSteals = 0;
+    uint64_t injectionContention = 0;   // Injection-queue lock acquisitions that had to wait
+    Histogram queueLatency = {};        // Enqueue to start
+    Histogram runTime = {};
+    int queuedTasks = 0;
+    int activeTasks = 0;
+    chrono::nanoseconds uptime = chrono::nanoseconds(0);
+
+    static auto bucketFor(chrono::nanoseconds duration) -> size_t {
+        auto micros = chrono::duration_cast<chrono::microseconds>(duration).count();
+        if (micros <= 0)
+            return 0;
+        return min(HISTOGRAM_BUCKETS - 1, static_cast<size_t>(bit_width(static_cast<uint64_t>(micros))));
+    }
+
+    // Exclusive upper edge of a bucket (the last one is open-ended)
+    static auto bucketLimit(size_t bucket) -> chrono::microseconds {
+        return chrono::microseconds(int64_t(1) << bucket);
+    }
+
+    /** Upper edge of the bucket holding the given fraction (e.g. 0.99) of samples; 0 if empty */
+    static auto percentile(const Histogram& histogram, double fraction) -> chrono::microseconds {
+        auto total = uint64_t(0);
+        for (auto count : histogram)
+            total += count;
+        if (total == 0)
+            return chrono::microseconds(0);
+
+        auto target = static_cast<uint64_t>(fraction * static_cast<double>(total));
+        auto seen = uint64_t(0);
+        for (auto bucket = size_t(0); bucket < HISTOGRAM_BUCKETS; bucket++) {
+            seen += histogram[bucket];
+            if (seen > target || seen == total)
+                return bucketLimit(bucket);
+        }
+        return bucketLimit(HISTOGRAM_BUCKETS - 1);
+    }
+};
+
+
+/**
+ * ThreadPool - Work-stealing thread pool
+ *
+ * - Each worker owns a Chase-Lev deque; tasks enqueued from inside a task go there
+ *   (no lock, and the child runs on the core that produced its data)
+ * - Tasks enqueued from outside the pool go into a shared injection queue, ordered by
+ *   priority (tasks spawned inside the pool stay on their worker's deque)
+ * - An idle worker pops its own deque, then the injection queue, then steals from
+ *   the other workers starting at a random victim
+ * - Workers with nothing to do sleep on a condition variable and are only woken
+ *   when someone is actually asleep
+ *
+ * Destruction runs every task already enqueued (including ones they enqueue) before joining.
+ *
+ * enqueue() is fire-and-forget; submit() returns a future, and TaskGroup (TaskGroup.hpp)
+ * joins a specific set of tasks.
+ *
+ * Tasks are UniqueTasks (move-only, 64-byte inline storage) held in recycled slots:
+ * each thread keeps a small free list and trades batches with a shared one, so a
+ * steady stream of small lambdas is moved end to end without touching the heap.
+ *
+ * Instrumentation (on by default, setStatsEnabled(false) to skip it): every thread bumps
+ * only its own cache line of relaxed counters, plus two clock reads per task.
+ * getStats() sums them into a ThreadPoolStats snapshot.
+ */
 class ThreadPool {
 private:
+    struct Task {
+        UniqueTask fn;
+        chrono::steady_clock::time_point enqueuedAt;    // Zero unless stats were on at enqueue
+    };
+
+    // Written by one worker (or, for externalStats, by outside threads); read by getStats()
+    struct alignas(64) Counters {
+        atomic<uint64_t> enqueued{0};
+        atomic<uint64_t> tasksRun{0};
+        atomic<uint64_t> busyNanos{0};
+        atomic<uint64_t> steals{0};
+        atomic<uint64_t> failedSteals{0};
+        array<atomic<uint64_t>, ThreadPoolStats::HISTOGRAM_BUCKETS> queueLatency{};
+        array<atomic<uint64_t>, ThreadPoolStats::HISTOGRAM_BUCKETS> runTime{};
+    };
+
+    // Per-thread free list of task slots; spills to / refills from the shared list in batches
+    struct SlotCache {
+        static constexpr size_t BATCH = 64;
+        static constexpr size_t SHARED_LIMIT = 4096;    // Beyond this, surplus slots are freed
+
+        vector<unique_ptr<Task>> slots;
+
+        ~SlotCache() { ThreadPool::spillSlots(this->slots, this->slots.size()); }
+    };
+
+    struct alignas(64) Worker {
+        WorkStealingDeque<Task*> deque;
+        Counters stats;     // Own cache line: thieves touching the deque don't contend with it
+    };
+
     size_t nthreads;
-    vector<thread> workers;
-    TaskQueue<function<void()>> taskQueue;  // Clean abstraction!
-    atomic<int> activeTasks;
+    vector<unique_ptr<Worker>> queues;
+    TaskQueue<Task*> injectionQueue;        // Submits from threads outside the pool
+    atomic<int> queuedTasks;                // Enqueued but not yet started
+    atomic<int> activeTasks;                // Currently running
+    atomic<int> sleepingWorkers;
+    atomic<bool> stopping;
+    mutex sleepMutex;
+    condition_variable wakeCondition;
+    atomic<bool> statsEnabled;
+    Counters externalStats;                 // Threads outside the pool
+    chrono::steady_clock::time_point createdAt;
+    vector<thread> workers;                 // Last: threads start after everything above exists
+
+    // Which pool/worker the current thread belongs to (nullptr outside any pool)
+    inline static thread_local ThreadPool* currentPool = nullptr;
+    inline static thread_local size_t currentWorker = 0;
+    inline static mutex sharedSlotsMutex;
+    inline static vector<unique_ptr<Task>> sharedSlots;
+    inline static thread_local SlotCache slotCache;
+    inline static thread_local uint32_t stealRng = static_cast<uint32_t>(hash<thread::id>()(this_thread::get_id())) | 1;
+    inline static thread_local bool idleStealCounted = false;  // Failed steal already counted since the last task
 
 public:
     ThreadPool(size_t nthreads)
         : nthreads(nthreads),
-          workers(),
-          taskQueue(),
-          activeTasks(0) {
+          queues(),
+          injectionQueue(),
+          queuedTasks(0),
+          activeTasks(0),
+          sleepingWorkers(0),
+          stopping(false),
+          sleepMutex(),
+          wakeCondition(),
+          statsEnabled(true),
+          externalStats(),
+          createdAt(chrono::steady_clock::now()),
+          workers() {
+
+        for (auto i = size_t(0); i < nthreads; i++)
+            this->queues.push_back(make_unique<Worker>());
 
         for (auto i = size_t(0); i < nthreads; i++)
-            this->workers.emplace_back([this] { this->workerLoop(); });
+            this->workers.emplace_back([this, i] { this->workerLoop(i); });
     }
 
     ~ThreadPool() {
-        // Signal shutdown
-        this->taskQueue.shutdown();
+        // Signal shutdown; workers drain what is queued, then exit
+        {
+            auto lock = lock_guard<mutex>(this->sleepMutex);
+            this->stopping = true;
+        }
+        this->wakeCondition.notify_all();
 
         for (auto& worker : this->workers) {
             if (worker.joinable())
@@ -37,22 +216,286 @@ public:
         }
     }
 
-    void enqueue(function<void()> task) {
-        this->taskQueue.push(task);
+    void enqueue(UniqueTask task, TaskPriority priority = TaskPriority::Normal) {
+        auto* item = this->acquireSlot();
+        item->fn = move(task);
+
+        // Count before publishing so isIdle() never sees a queued task as missing
+        this->queuedTasks++;
+        if (currentPool == this)
+            this->queues[currentWorker]->deque.push(item);
+        else
+            this->injectionQueue.push(item, priority);
+
+        if (this->isStatsEnabled())
+            this->localStats().enqueued.fetch_add(1, memory_order_relaxed);
+        this->wakeOne();
+    }
+
+    /** Enqueue many tasks with one injection-queue lock and one wake-up round */
+    void enqueueBulk(vector<UniqueTask>&& tasks, TaskPriority priority = TaskPriority::Normal) {
+        if (tasks.empty())
+            return;
+
+        auto items = vector<Task*>();
+        items.reserve(tasks.size());
+        for (auto& task : tasks) {
+            auto* item = this->acquireSlot();
+            item->fn = move(task);
+            items.push_back(item);
+        }
+
+        this->queuedTasks += static_cast<int>(items.size());
+        if (currentPool == this) {
+            for (auto* item : items)
+                this->queues[currentWorker]->deque.push(item);
+        }
+        else {
+            this->injectionQueue.pushBulk(move(items), priority);
+        }
+        if (this->isStatsEnabled())
+            this->localStats().enqueued.fetch_add(tasks.size(), memory_order_relaxed);
+
+        if (tasks.size() == 1)
+            this->wakeOne();
+        else
+            this->wakeAll();
+        tasks.clear();
     }
 
-    auto isIdle() const { return this->taskQueue.empty() && this->activeTasks == 0; }
-    auto getQueueSize() const { return this->taskQueue.size(); }
+    /** Enqueue a callable and get a future for its result (exceptions are rethrown by get()) */
+    template<typename F>
+    auto submit(F&& fn) -> future<invoke_result_t<decay_t<F>>> {
+        using Result = invoke_result_t<decay_t<F>>;
+
+        auto task = packaged_task<Result()>(forward<F>(fn));
+        auto result = task.get_future();
+        this->enqueue([task = move(task)]() mutable { task(); });
+        return result;
+    }
+
+    /**
+     * Run one queued task on the calling thread; returns false if none was found.
+     * Lets a thread that waits on pool work help instead of blocking a core (and
+     * avoids deadlock when the waiter is itself a pool worker).
+     */
+    auto runPendingTask() -> bool {
+        auto* task = (currentPool == this)
+            ? this->findTask(currentWorker)
+            : this->findExternalTask();
+        if (!task)
+            return false;
+
+        this->runTask(task, this->localStats());
+        return true;
+    }
+
+    // Exact: a task is counted as queued until it is counted as active
+    auto isIdle() const { return this->queuedTasks == 0 && this->activeTasks == 0; }
+    auto getQueueSize() const { return this->queuedTasks.load(); }
     auto getThreadCount() const { return this->nthreads; }
 
+    /** Counters keep their values while off; tasks enqueued while off report no queue latency */
+    void setStatsEnabled(bool enabled) { this->statsEnabled.store(enabled, memory_order_relaxed); }
+    auto isStatsEnabled() const -> bool { return this->statsEnabled.load(memory_order_relaxed); }
+
+    /** Any thread; counters are read one by one, so a snapshot taken mid-task may be off by that task */
+    auto getStats() const -> ThreadPoolStats {
+        auto stats = ThreadPoolStats();
+        stats.uptime = chrono::steady_clock::now() - this->createdAt;
+
+        for (const auto& worker : this->queues) {
+            auto workerStats = this->collect(worker->stats, stats);
+            workerStats.idleTime = max(chrono::nanoseconds(0), stats.uptime - workerStats.busyTime);
+            stats.workers.push_back(workerStats);
+        }
+        stats.external = this->collect(this->externalStats, stats);
+
+        stats.injectionContention = this->injectionQueue.getContentionCount();
+        stats.queuedTasks = this->queuedTasks.load();
+        stats.activeTasks = this->activeTasks.load();
+        return stats;
+    }
+
 private:
-    void workerLoop() {
-        // Loop while tasks are available; pop() returns nullopt on shutdown
-        while (auto taskOpt = this->taskQueue.pop()) {
-            auto task = taskOpt.value();
-            this->activeTasks++;
-            task();
-            this->activeTasks--;
+    void workerLoop(size_t index) {
+        currentPool = this;
+        currentWorker = index;
+
+        while (true) {
+            if (auto* task = this->findTask(index)) {
+                this->runTask(task, this->queues[index]->stats);
+                continue;
+            }
+
+            if (this->queuedTasks > 0) {
+                // Counted but not published yet, or lost a steal race; retry shortly
+                this_thread::yield();
+                continue;
+            }
+
+            if (this->stopping)
+                return;
+            this->sleep();
+        }
+    }
+
+    void runTask(Task* task, Counters& stats) {
+        idleStealCounted = false;   // Next fruitless sweep starts a new idle period
+        this->activeTasks++;
+        this->queuedTasks--;
+
+        if (this->isStatsEnabled()) {
+            auto start = chrono::steady_clock::now();
+            task->fn();
+            this->recordRun(stats, task->enqueuedAt, start);
+        }
+        else {
+            task->fn();
+        }
+
+        releaseSlot(task);
+        this->activeTasks--;
+    }
+
+    static void recordRun(Counters& stats, chrono::steady_clock::time_point enqueuedAt, chrono::steady_clock::time_point start) {
+        auto elapsed = chrono::steady_clock::now() - start;
+        if (enqueuedAt != chrono::steady_clock::time_point())
+            stats.queueLatency[ThreadPoolStats::bucketFor(start - enqueuedAt)].fetch_add(1, memory_order_relaxed);
+        stats.runTime[ThreadPoolStats::bucketFor(elapsed)].fetch_add(1, memory_order_relaxed);
+        stats.busyNanos.fetch_add(static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(elapsed).count()), memory_order_relaxed);
+        stats.tasksRun.fetch_add(1, memory_order_relaxed);
+    }
+
+    // Read one block of counters and add it to the pool-wide totals
+    static auto collect(const Counters& counters, ThreadPoolStats& totals) -> ThreadPoolStats::WorkerStats {
+        auto stats = ThreadPoolStats::WorkerStats();
+        stats.tasksRun = counters.tasksRun.load(memory_order_relaxed);
+        stats.steals = counters.steals.load(memory_order_relaxed);
+        stats.failedSteals = counters.failedSteals.load(memory_order_relaxed);
+        stats.busyTime = chrono::nanoseconds(counters.busyNanos.load(memory_order_relaxed));
+
+        totals.tasksEnqueued += counters.enqueued.load(memory_order_relaxed);
+        totals.tasksRun += stats.tasksRun;
+        totals.steals += stats.steals;
+        totals.failedSteals += stats.failedSteals;
+        for (auto bucket = size_t(0); bucket < ThreadPoolStats::HISTOGRAM_BUCKETS; bucket++) {
+            totals.queueLatency[bucket] += counters.queueLatency[bucket].load(memory_order_relaxed);
+            totals.runTime[bucket] += counters.runTime[bucket].load(memory_order_relaxed);
+        }
+        return stats;
+    }
+
+    // The calling thread's counters: its worker's, or the shared external block
+    auto localStats() -> Counters& {
+        return (currentPool == this) ? this->queues[currentWorker]->stats : this->externalStats;
+    }
+
+    auto acquireSlot() -> Task* {
+        auto* slot = takeSlot();
+        slot->enqueuedAt = this->isStatsEnabled()
+            ? chrono::steady_clock::now()
+            : chrono::steady_clock::time_point();
+        return slot;
+    }
+
+    static auto takeSlot() -> Task* {
+        auto& slots = slotCache.slots;
+        if (slots.empty()) {
+            auto lock = lock_guard<mutex>(sharedSlotsMutex);
+            auto count = min(SlotCache::BATCH, sharedSlots.size());
+            move(sharedSlots.end() - count, sharedSlots.end(), back_inserter(slots));
+            sharedSlots.resize(sharedSlots.size() - count);
         }
+        if (slots.empty())
+            return new Task();
+
+        auto* slot = slots.back().release();
+        slots.pop_back();
+        return slot;
+    }
+
+    static void releaseSlot(Task* slot) {
+        slot->fn.reset();  // Destroy captures now, not when the slot is reused
+        auto& slots = slotCache.slots;
+        slots.emplace_back(slot);
+        if (slots.size() > 2 * SlotCache::BATCH)
+            spillSlots(slots, SlotCache::BATCH);
+    }
+
+    static void spillSlots(vector<unique_ptr<Task>>& slots, size_t count) {
+        auto lock = lock_guard<mutex>(sharedSlotsMutex);
+        for (auto i = size_t(0); i < count; i++) {
+            if (sharedSlots.size() < SlotCache::SHARED_LIMIT)
+                sharedSlots.push_back(move(slots.back()));
+            slots.pop_back();
+        }
+    }
+
+    auto findTask(size_t index) -> Task* {
+        if (auto task = this->queues[index]->deque.pop())
+            return *task;
+        if (auto task = this->injectionQueue.tryPop())
+            return *task;
+        return this->steal(index);
+    }
+
+    // For threads outside the pool: no own deque to check
+    auto findExternalTask() -> Task* {
+        if (auto task = this->injectionQueue.tryPop())
+            return *task;
+        return this->steal(this->nthreads);
+    }
+
+    // thief == nthreads means the caller is not a worker, so no victim is skipped
+    auto steal(size_t thief) -> Task* {
+        if (this->nthreads == 0)
+            return nullptr;
+
+        // Random start (xorshift32) spreads thieves across victims instead of all hitting worker 0
+        stealRng ^= stealRng << 13;
+        stealRng ^= stealRng >> 17;
+        stealRng ^= stealRng << 5;
+
+        auto& stats = (thief < this->nthreads) ? this->queues[thief]->stats : this->externalStats;
+        auto start = static_cast<size_t>(stealRng % this->nthreads);
+        for (auto i = size_t(0); i < this->nthreads; i++) {
+            auto victim = (start + i) % this->nthreads;
+            if (victim == thief)
+                continue;
+            if (auto task = this->queues[victim]->deque.steal()) {
+                if (this->isStatsEnabled())
+                    stats.steals.fetch_add(1, memory_order_relaxed);
+                return *task;
+            }
+        }
+        // Once per idle period: a spinning or helping thread retries this many times
+        if (!idleStealCounted && this->isStatsEnabled()) {
+            stats.failedSteals.fetch_add(1, memory_order_relaxed);
+            idleStealCounted = true;
+        }
+        return nullptr;
+    }
+
+    void sleep() {
+        auto lock = unique_lock<mutex>(this->sleepMutex);
+        this->sleepingWorkers++;
+        this->wakeCondition.wait(lock, [this] { return this->stopping || this->queuedTasks > 0; });
+        this->sleepingWorkers--;
+    }
+
+    void wakeOne() {
+        // Sleepers register before re-checking queuedTasks, so this can't miss one
+        if (this->sleepingWorkers == 0)
+            return;
+        auto lock = lock_guard<mutex>(this->sleepMutex);
+        this->wakeCondition.notify_one();
+    }
+
+    void wakeAll() {
+        if (this->sleepingWorkers == 0)
+            return;
+        auto lock = lock_guard<mutex>(this->sleepMutex);
+        this->wakeCondition.notify_all();
     }
 };
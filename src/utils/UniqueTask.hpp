@@ -0,0 +1,108 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <memory>
+#include <utility>
+#include <type_traits>
+
+using namespace std;
+
+
+/**
+ * UniqueTask - Move-only void() callable with small-buffer storage
+ *
+ * Callables up to INLINE_SIZE bytes (that can be moved without throwing) live inside the
+ * task itself, so wrapping a typical lambda costs no allocation; larger ones fall back to
+ * the heap. Unlike std::function it accepts move-only captures (unique_ptr, buffers,
+ * packaged_task) and is never copied.
+ */
+class UniqueTask {
+public:
+    static constexpr size_t INLINE_SIZE = 64;
+
+private:
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*relocate)(void* dst, void* src);  // Move-construct into dst, destroy src
+        void (*destroy)(void* storage);
+    };
+
+    template<typename F>
+    static constexpr bool fitsInline = sizeof(F) <= INLINE_SIZE
+        && alignof(F) <= alignof(max_align_t)
+        && is_nothrow_move_constructible_v<F>;
+
+    // Callable stored in the buffer itself
+    template<typename F>
+    static constexpr Ops inlineOps = {
+        [](void* storage) { (*static_cast<F*>(storage))(); },
+        [](void* dst, void* src) {
+            ::new (dst) F(move(*static_cast<F*>(src)));
+            static_cast<F*>(src)->~F();
+        },
+        [](void* storage) { static_cast<F*>(storage)->~F(); },
+    };
+
+    // Buffer holds an owning F*
+    template<typename F>
+    static constexpr Ops heapOps = {
+        [](void* storage) { (**static_cast<F**>(storage))(); },
+        [](void* dst, void* src) { *static_cast<F**>(dst) = *static_cast<F**>(src); },
+        [](void* storage) { delete *static_cast<F**>(storage); },
+    };
+
+    alignas(max_align_t) unsigned char storage[INLINE_SIZE];
+    const Ops* ops;
+
+public:
+    UniqueTask()
+        : storage(),
+          ops(nullptr) {
+    }
+
+    template<typename F, typename Fn = decay_t<F>,
+             typename = enable_if_t<!is_same_v<Fn, UniqueTask> && is_invocable_v<Fn&>>>
+    UniqueTask(F&& fn)
+        : ops(nullptr) {
+        if constexpr (fitsInline<Fn>) {
+            ::new (static_cast<void*>(this->storage)) Fn(forward<F>(fn));
+            this->ops = &inlineOps<Fn>;
+        } else {
+            ::new (static_cast<void*>(this->storage)) Fn*(new Fn(forward<F>(fn)));
+            this->ops = &heapOps<Fn>;
+        }
+    }
+
+    ~UniqueTask() { this->reset(); }
+
+    UniqueTask(const UniqueTask&) = delete;
+    UniqueTask& operator=(const UniqueTask&) = delete;
+
+    UniqueTask(UniqueTask&& other) noexcept
+        : ops(other.ops) {
+        if (this->ops)
+            this->ops->relocate(this->storage, other.storage);
+        other.ops = nullptr;
+    }
+
+    UniqueTask& operator=(UniqueTask&& other) noexcept {
+        if (this != &other) {
+            this->reset();
+            this->ops = other.ops;
+            if (this->ops)
+                this->ops->relocate(this->storage, other.storage);
+            other.ops = nullptr;
+        }
+        return *this;
+    }
+
+    void operator()() { this->ops->invoke(this->storage); }
+    explicit operator bool() const { return this->ops != nullptr; }
+
+    /** Destroy the held callable (and its captures) now */
+    void reset() {
+        if (this->ops)
+            this->ops->destroy(this->storage);
+        this->ops = nullptr;
+    }
+};
@@ -0,0 +1,137 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <optional>
+#include <cstdint>
+#include <type_traits>
+
+using namespace std;
+
+
+/**
+ * WorkStealingDeque - Chase-Lev lock-free deque (Le, Pop, Cohen, Zappa Nardelli 2013)
+ *
+ * The owning thread pushes and pops at the bottom (LIFO, cache-warm); any other thread
+ * may steal from the top (FIFO, oldest work first). Only steals that race for the same
+ * last item pay a CAS; the owner's push/pop are otherwise plain loads and stores.
+ *
+ * The ring grows when full. Old rings are kept until the deque is destroyed, because a
+ * thief may still be reading from one; growth doubles, so this at most doubles memory.
+ *
+ * T must be trivially copyable (typically a pointer).
+ */
+template<typename T>
+class WorkStealingDeque {
+    static_assert(is_trivially_copyable_v<T>, "WorkStealingDeque stores items in atomics");
+
+private:
+    struct Ring {
+        int64_t capacity;
+        unique_ptr<atomic<T>[]> slots;
+
+        Ring(int64_t capacity)
+            : capacity(capacity),
+              slots(new atomic<T>[static_cast<size_t>(capacity)]) {
+        }
+
+        auto get(int64_t index) const -> T { return this->slots[index & (this->capacity - 1)].load(memory_order_relaxed); }
+        void put(int64_t index, T item) { this->slots[index & (this->capacity - 1)].store(item, memory_order_relaxed); }
+
+        auto grow(int64_t bottom, int64_t top) const -> Ring* {
+            auto* bigger = new Ring(this->capacity * 2);
+            for (auto i = top; i < bottom; i++)
+                bigger->put(i, this->get(i));
+            return bigger;
+        }
+    };
+
+    alignas(64) atomic<int64_t> top;        // Thieves take from here
+    alignas(64) atomic<int64_t> bottom;     // Owner pushes/pops here
+    atomic<Ring*> ring;
+    vector<unique_ptr<Ring>> rings;         // Current ring + retired ones (owner only)
+
+public:
+    WorkStealingDeque(int64_t initialCapacity = 256)
+        : top(0),
+          bottom(0),
+          ring(nullptr),
+          rings() {
+        // Capacity must be a power of two for index masking
+        auto capacity = int64_t(1);
+        while (capacity < initialCapacity)
+            capacity *= 2;
+
+        this->rings.push_back(make_unique<Ring>(capacity));
+        this->ring.store(this->rings.back().get(), memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /** Owner only */
+    void push(T item) {
+        auto b = this->bottom.load(memory_order_relaxed);
+        auto t = this->top.load(memory_order_acquire);
+        auto* current = this->ring.load(memory_order_relaxed);
+
+        if (b - t > current->capacity - 1) {
+            this->rings.emplace_back(current->grow(b, t));
+            current = this->rings.back().get();
+            this->ring.store(current, memory_order_release);
+        }
+
+        current->put(b, item);
+        atomic_thread_fence(memory_order_release);
+        this->bottom.store(b + 1, memory_order_relaxed);
+    }
+
+    /** Owner only; newest item first */
+    auto pop() -> optional<T> {
+        auto b = this->bottom.load(memory_order_relaxed) - 1;
+        auto* current = this->ring.load(memory_order_relaxed);
+        this->bottom.store(b, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        auto t = this->top.load(memory_order_relaxed);
+
+        if (t > b) {
+            // Empty
+            this->bottom.store(b + 1, memory_order_relaxed);
+            return nullopt;
+        }
+
+        auto item = current->get(b);
+        if (t == b) {
+            // Last item: race thieves for it
+            auto won = this->top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed);
+            this->bottom.store(b + 1, memory_order_relaxed);
+            if (!won)
+                return nullopt;
+        }
+        return item;
+    }
+
+    /** Any thread; oldest item first. Returns nullopt if empty or if another thief won the race */
+    auto steal() -> optional<T> {
+        auto t = this->top.load(memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        auto b = this->bottom.load(memory_order_acquire);
+
+        if (t >= b)
+            return nullopt;
+
+        auto item = this->ring.load(memory_order_acquire)->get(t);
+        if (!this->top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed))
+            return nullopt;
+        return item;
+    }
+
+    /** Approximate when called concurrently */
+    auto size() const -> size_t {
+        auto b = this->bottom.load(memory_order_relaxed);
+        auto t = this->top.load(memory_order_relaxed);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+
+    auto empty() const -> bool { return this->size() == 0; }
+};
@@ -0,0 +1,179 @@
+// AssetPacker - Build-time tool that packs a directory of assets for fast loading
+//
+// Usage: AssetPacker <input-dir> [--archive <file>] [--manifest <file>] [--ext <.ext>]...
+//   e.g. AssetPacker assets/images/icons --archive bin/assets/images/icons.pak
+//                                        --manifest bin/assets/images/icons.manifest --ext .png
+//
+// --archive  writes the format described in src/utils/AssetArchive.hpp: a sorted index
+//            followed by contiguous data blobs, ready to be memory-mapped by AssetManager.
+// --manifest writes the format described in src/utils/AssetManifest.hpp: every asset with
+//            its size, dimensions and content hash.
+
+#include "../src/utils/AssetArchive.hpp"
+#include "../src/utils/AssetManifest.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+
+struct PackInput {
+    string name;
+    vector<char> data;
+};
+
+auto alignUp(uint64_t value, uint64_t alignment) -> uint64_t {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+auto readWholeFile(const filesystem::path& path, vector<char>& out) -> bool {
+    auto file = ifstream(path, ios::binary | ios::ate);
+    if (!file.is_open())
+        return false;
+
+    auto size = file.tellg();
+    file.seekg(0, ios::beg);
+    out.resize(static_cast<size_t>(size));
+    return static_cast<bool>(file.read(out.data(), size));
+}
+
+// Read width/height from a PNG IHDR chunk (0x0 for anything that isn't a PNG)
+auto readPngSize(const vector<char>& data) -> pair<uint32_t, uint32_t> {
+    static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    if (data.size() < 24 || memcmp(data.data(), signature, sizeof(signature)) != 0)
+        return {0, 0};
+
+    auto readBigEndian = [&](size_t offset) {
+        auto value = uint32_t(0);
+        for (auto i = size_t(0); i < 4; i++)
+            value = (value << 8) | static_cast<unsigned char>(data[offset + i]);
+        return value;
+    };
+    return {readBigEndian(16), readBigEndian(20)};
+}
+
+auto writeManifest(const string& outputPath, const vector<PackInput>& inputs) -> bool {
+    auto entries = vector<AssetManifestEntry>();
+    entries.reserve(inputs.size());
+
+    for (const auto& input : inputs) {
+        auto [width, height] = readPngSize(input.data);
+        auto hash = AssetManifest::hashBytes(input.data.data(), input.data.size());
+        entries.push_back({input.name, input.data.size(), width, height, hash});
+    }
+    return AssetManifest::write(outputPath, move(entries));
+}
+
+auto collectInputs(const filesystem::path& dir, const vector<string>& extensions) -> vector<PackInput> {
+    auto inputs = vector<PackInput>();
+    for (const auto& entry : filesystem::directory_iterator(dir)) {
+        if (!entry.is_regular_file())
+            continue;
+
+        auto ext = entry.path().extension().string();
+        if (!extensions.empty() && ranges::find(extensions, ext) == extensions.end())
+            continue;
+
+        auto input = PackInput{entry.path().filename().string(), {}};
+        if (!readWholeFile(entry.path(), input.data)) {
+            cerr << "[AssetPacker] Failed to read: " << entry.path().string() << endl;
+            continue;
+        }
+        inputs.push_back(move(input));
+    }
+
+    // Sorted index lets the loader binary-search and enumerate in a stable order
+    ranges::sort(inputs, {}, &PackInput::name);
+    return inputs;
+}
+
+auto writeArchive(const string& outputPath, const vector<PackInput>& inputs) -> bool {
+    auto header = ArchiveHeader();
+    memcpy(header.magic, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+    header.version = ARCHIVE_VERSION;
+    header.entryCount = static_cast<uint32_t>(inputs.size());
+
+    // Lay out index, then names, then aligned data blobs
+    auto entries = vector<ArchiveEntry>(inputs.size());
+    auto offset = uint64_t(sizeof(ArchiveHeader) + inputs.size() * sizeof(ArchiveEntry));
+
+    for (auto i = size_t(0); i < inputs.size(); i++) {
+        entries[i].nameOffset = static_cast<uint32_t>(offset);
+        entries[i].nameLength = static_cast<uint32_t>(inputs[i].name.size());
+        offset += inputs[i].name.size();
+    }
+    for (auto i = size_t(0); i < inputs.size(); i++) {
+        offset = alignUp(offset, ARCHIVE_ALIGNMENT);
+        entries[i].dataOffset = offset;
+        entries[i].dataSize = inputs[i].data.size();
+        offset += inputs[i].data.size();
+    }
+
+    auto file = ofstream(outputPath, ios::binary | ios::trunc);
+    if (!file.is_open())
+        return false;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(ArchiveEntry));
+    for (const auto& input : inputs)
+        file.write(input.name.data(), input.name.size());
+
+    static const char padding[ARCHIVE_ALIGNMENT] = {};
+    for (auto i = size_t(0); i < inputs.size(); i++) {
+        auto position = static_cast<uint64_t>(file.tellp());
+        file.write(padding, static_cast<streamsize>(entries[i].dataOffset - position));
+        file.write(inputs[i].data.data(), inputs[i].data.size());
+    }
+    return static_cast<bool>(file);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        cerr << "Usage: AssetPacker <input-dir> [--archive <file>] [--manifest <file>] [--ext <.ext>]..." << endl;
+        return 1;
+    }
+
+    auto inputDir = filesystem::path(argv[1]);
+    auto archivePath = string();
+    auto manifestPath = string();
+    auto extensions = vector<string>();
+
+    for (auto i = 2; i + 1 < argc; i += 2) {
+        auto flag = string(argv[i]);
+        if (flag == "--archive")
+            archivePath = argv[i + 1];
+        else if (flag == "--manifest")
+            manifestPath = argv[i + 1];
+        else if (flag == "--ext")
+            extensions.emplace_back(argv[i + 1]);
+        else {
+            cerr << "[AssetPacker] Unknown option: " << flag << endl;
+            return 1;
+        }
+    }
+
+    if (!filesystem::is_directory(inputDir)) {
+        cerr << "[AssetPacker] Not a directory: " << inputDir.string() << endl;
+        return 1;
+    }
+
+    auto inputs = collectInputs(inputDir, extensions);
+
+    if (!archivePath.empty()) {
+        if (!writeArchive(archivePath, inputs)) {
+            cerr << "[AssetPacker] Failed to write: " << archivePath << endl;
+            return 1;
+        }
+        cout << "[AssetPacker] Packed " << inputs.size() << " assets into " << archivePath << endl;
+    }
+
+    if (!manifestPath.empty()) {
+        if (!writeManifest(manifestPath, inputs)) {
+            cerr << "[AssetPacker] Failed to write: " << manifestPath << endl;
+            return 1;
+        }
+        cout << "[AssetPacker] Wrote manifest of " << inputs.size() << " assets to " << manifestPath << endl;
+    }
+    return 0;
+}